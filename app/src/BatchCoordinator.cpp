@@ -0,0 +1,456 @@
+#include "BatchCoordinator.h"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "PlannerRegistry.h"
+#include "struct/Drone.h"
+struct BatchError : std::runtime_error { using std::runtime_error::runtime_error; };
+
+namespace {
+
+// Result frame sent by a worker: header, then `bytes` of payload. The
+// payload is an encoded RunResult (kOk) or an error message (kFailed).
+struct FrameHeader {
+    std::int32_t  scenario;
+    std::int32_t  status;
+    std::uint64_t bytes;
+};
+constexpr std::int32_t kOk     = 0;
+constexpr std::int32_t kFailed = 1;
+
+bool writeAll(int fd, const void* data, std::size_t n) noexcept {
+    const char* p = static_cast<const char*>(data);
+    while (n > 0) {
+        const ssize_t w = ::write(fd, p, n);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return false;
+        p += w;
+        n -= static_cast<std::size_t>(w);
+    }
+    return true;
+}
+
+// False on EOF or error before n bytes arrived
+bool readAll(int fd, void* data, std::size_t n) noexcept {
+    char* p = static_cast<char*>(data);
+    while (n > 0) {
+        const ssize_t r = ::read(fd, p, n);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return false;
+        p += r;
+        n -= static_cast<std::size_t>(r);
+    }
+    return true;
+}
+
+void closeFd(int& fd) noexcept {
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+}
+
+template <class T>
+void append(std::string& out, const T& v) {
+    out.append(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+template <class T>
+T take(const std::string& in, std::size_t& at) {
+    if (in.size() - at < sizeof(T)) throw BatchError("truncated result frame");
+    T v;
+    std::memcpy(&v, in.data() + at, sizeof(T));
+    at += sizeof(T);
+    return v;
+}
+
+std::string encode(const RunResult& r) {
+    std::string out;
+    append<std::int64_t>(out, r.totalScore);
+    append<std::int32_t>(out, r.drones);
+    append<std::int32_t>(out, r.timeElapsedMs);
+    append<std::uint64_t>(out, r.paths.size());
+    for (const auto& p : r.paths) {
+        append<std::int32_t>(out, p.droneId);
+        append<std::uint64_t>(out, p.path.size());
+        out.append(reinterpret_cast<const char*>(p.path.data()), p.path.size() * sizeof(Step));
+    }
+    append<std::uint8_t>(out, r.stepLatency ? 1 : 0);
+    if (const auto& l = r.stepLatency) {
+        append<std::int32_t>(out, l->deadlineUs);
+        for (const long long v : { l->steps, l->degradedSteps, l->missedSteps, l->shallowPlans, l->cachedMoves }) {
+            append<std::int64_t>(out, v);
+        }
+        for (const double v : { l->p50Us, l->p99Us, l->maxUs }) append<double>(out, v);
+        append<std::uint64_t>(out, l->histogram.size());
+        for (const auto& b : l->histogram) {
+            append<double>(out, b.leUs);
+            append<std::int64_t>(out, b.count);
+        }
+    }
+    append<std::uint8_t>(out, r.summary ? 1 : 0);
+    if (const auto& m = r.summary) {
+        append<std::int64_t>(out, m->steps);
+        append<std::int64_t>(out, m->distinctCells);
+        append<std::uint64_t>(out, m->valueHistogram.size());
+        for (const long long c : m->valueHistogram) append<std::int64_t>(out, c);
+    }
+    return out;
+}
+
+RunResult decode(const std::string& in) {
+    std::size_t at = 0;
+    RunResult r;
+    r.totalScore    = take<std::int64_t>(in, at);
+    r.drones        = take<std::int32_t>(in, at);
+    r.timeElapsedMs = take<std::int32_t>(in, at);
+    const auto paths = take<std::uint64_t>(in, at);
+    for (std::uint64_t i = 0; i < paths; ++i) {
+        DronePath p;
+        p.droneId = take<std::int32_t>(in, at);
+        const auto steps = take<std::uint64_t>(in, at);
+        if (steps > (in.size() - at) / sizeof(Step)) throw BatchError("truncated result frame");
+        p.path.resize(steps);
+        std::memcpy(p.path.data(), in.data() + at, steps * sizeof(Step));
+        at += steps * sizeof(Step);
+        r.paths.push_back(std::move(p));
+    }
+    if (take<std::uint8_t>(in, at) != 0) {
+        StepLatency& l = r.stepLatency.emplace();
+        l.deadlineUs = take<std::int32_t>(in, at);
+        for (long long* v : { &l.steps, &l.degradedSteps, &l.missedSteps, &l.shallowPlans, &l.cachedMoves }) {
+            *v = take<std::int64_t>(in, at);
+        }
+        for (double* v : { &l.p50Us, &l.p99Us, &l.maxUs }) *v = take<double>(in, at);
+        const auto buckets = take<std::uint64_t>(in, at);
+        for (std::uint64_t i = 0; i < buckets; ++i) {
+            const double leUs = take<double>(in, at);
+            l.histogram.push_back(StepLatency::Bucket{ leUs, take<std::int64_t>(in, at) });
+        }
+    }
+    if (take<std::uint8_t>(in, at) != 0) {
+        RunSummary& m = r.summary.emplace();
+        m.steps         = take<std::int64_t>(in, at);
+        m.distinctCells = take<std::int64_t>(in, at);
+        const auto bins = take<std::uint64_t>(in, at);
+        for (std::uint64_t i = 0; i < bins; ++i) m.valueHistogram.push_back(take<std::int64_t>(in, at));
+    }
+    return r;
+}
+
+std::string describeExit(int status) {
+    if (WIFSIGNALED(status)) {
+        const int sig = WTERMSIG(status);
+        const char* name = ::strsignal(sig);
+        return "worker killed by signal " + std::to_string(sig) + (name ? std::string(" (") + name + ")" : "");
+    }
+    if (WIFEXITED(status)) {
+        return "worker exited with status " + std::to_string(WEXITSTATUS(status));
+    }
+    return "worker stopped unexpectedly";
+}
+
+} // namespace
+
+BatchCoordinator::BatchCoordinator(std::unique_ptr<Grid> grid, ParamSections params, int workers)
+    : m_grid(std::move(grid))
+    , m_params(std::move(params))
+    , m_workers(workers > 0 ? workers : static_cast<int>(std::max(1u, std::thread::hardware_concurrency())))
+{
+    if (!m_grid) {
+        throw BatchError("Grid is null");
+    }
+    shareGrid();
+}
+
+BatchCoordinator::~BatchCoordinator() {
+    stopWorkers();
+    closeFd(m_shmFd);
+}
+
+void BatchCoordinator::shareGrid() {
+    Grid& g = *m_grid;
+    g.lastVisitTime = GridArray<TimeStep>{};
+
+    // Loaded with sharedMap: forked workers inherit the loader's own arrays,
+    // so the map is in RAM exactly once.
+    if (g.base.backing() == GridBacking::Shared && g.inc.backing() == GridBacking::Shared) {
+        if (!g.base.makeReadOnly() || !g.inc.makeReadOnly()) {
+            throw BatchError(std::string("Failed to protect shared map: ") + std::strerror(errno));
+        }
+        return;
+    }
+
+    // A private grid is copied into a shared memory object one array at a
+    // time, each released as soon as it is copied, so the peak is 1.5x the
+    // map rather than 2x.
+    const std::size_t n         = g.base.size();
+    const std::size_t bytes     = n * sizeof(CellValue);
+    const std::size_t page      = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t incOffset = (bytes + page - 1) / page * page;
+    const std::size_t total     = incOffset + bytes;
+
+    m_shmFd = ::memfd_create("drone_swarm_grid", MFD_CLOEXEC);
+    if (m_shmFd < 0) {
+        // Pre-memfd kernels: a POSIX shm object, unlinked right away so it
+        // goes when the last process closes it.
+        const std::string name = "/drone_swarm_grid_" + std::to_string(::getpid());
+        m_shmFd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+        if (m_shmFd >= 0) ::shm_unlink(name.c_str());
+    }
+    if (m_shmFd < 0) {
+        throw BatchError(std::string("Failed to create shared memory: ") + std::strerror(errno));
+    }
+    if (::ftruncate(m_shmFd, static_cast<off_t>(total)) != 0) {
+        throw BatchError(std::string("Failed to size shared memory: ") + std::strerror(errno));
+    }
+
+    void* p = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, m_shmFd, 0);
+    if (p == MAP_FAILED) {
+        throw BatchError(std::string("Failed to map shared memory: ") + std::strerror(errno));
+    }
+    std::memcpy(p, g.base.data(), bytes);
+    g.base = GridArray<CellValue>{};
+    std::memcpy(static_cast<char*>(p) + incOffset, g.inc.data(), bytes);
+    g.inc = GridArray<CellValue>{};
+    ::munmap(p, total);
+
+    // From here on the shared object is the only copy; workers inherit these
+    // read-only mappings and allocate their own visit times.
+    g.base.mapShared(m_shmFd, 0, n);
+    g.inc.mapShared(m_shmFd, incOffset, n);
+}
+
+BatchCoordinator::Worker BatchCoordinator::spawnWorker(const std::vector<Scenario>& scenarios) {
+    int task[2], result[2];
+    if (::pipe(task) != 0) {
+        throw BatchError(std::string("pipe failed: ") + std::strerror(errno));
+    }
+    if (::pipe(result) != 0) {
+        ::close(task[0]); ::close(task[1]);
+        throw BatchError(std::string("pipe failed: ") + std::strerror(errno));
+    }
+
+    std::cout.flush();
+    std::cerr.flush();
+    const pid_t pid = ::fork();
+    if (pid < 0) {
+        for (int fd : { task[0], task[1], result[0], result[1] }) ::close(fd);
+        throw BatchError(std::string("fork failed: ") + std::strerror(errno));
+    }
+    if (pid == 0) {
+        // Other workers' pipe ends must not stay open in this process, or
+        // they would never see end-of-input.
+        for (auto& w : m_live) {
+            closeFd(w.taskFd);
+            closeFd(w.resultFd);
+        }
+        ::close(task[1]);
+        ::close(result[0]);
+        workerMain(task[0], result[1], scenarios);
+    }
+
+    ::close(task[0]);
+    ::close(result[1]);
+    Worker w;
+    w.pid      = pid;
+    w.taskFd   = task[1];
+    w.resultFd = result[0];
+    return w;
+}
+
+void BatchCoordinator::workerMain(int taskFd, int resultFd, const std::vector<Scenario>& scenarios) {
+    int code = 0;
+    try {
+        Grid& g = *m_grid;
+        g.lastVisitTime.allocate(g.base.size());
+        g.lastVisitTime.fill(-1);
+
+        std::int32_t index;
+        while (readAll(taskFd, &index, sizeof(index))) {
+            FrameHeader header{ index, kOk, 0 };
+            std::string payload;
+            std::vector<Drone> drones;
+            bool pathless = false;
+            try {
+                if (index < 0 || static_cast<std::size_t>(index) >= scenarios.size()) {
+                    throw BatchError("bad scenario index " + std::to_string(index));
+                }
+                const Scenario& sc = scenarios[static_cast<std::size_t>(index)];
+                for (const auto& s : sc.starts()) {
+                    if (!g.inBounds(s.x, s.y)) {
+                        throw BatchError("Start position out of bounds: (" + std::to_string(s.x) + "," +
+                                         std::to_string(s.y) + ")");
+                    }
+                }
+                pathless = sc.algoConfig().summaryOnly;
+                drones.reserve(sc.starts().size());
+                for (std::size_t i = 0; i < sc.starts().size(); ++i) {
+                    drones.emplace_back(static_cast<int>(i), sc.starts()[i]);
+                    drones.back().resetToStart(pathless ? 0 : sc.algoConfig().totalSteps);
+                }
+                auto algo = PlannerRegistry::instance().create(sc.algo(), m_params);
+                payload = encode(algo->run(g, std::span<Drone>(drones), sc.algoConfig()));
+            } catch (const std::exception& e) {
+                header.status = kFailed;
+                payload = e.what();
+            }
+
+            // Only visited cells differ from a fresh grid, and every one of
+            // them is on some drone's path. A summary run kept no paths, so
+            // clear the whole array (O(grid), like the run's own memory).
+            if (pathless) {
+                g.lastVisitTime.fill(-1);
+            } else {
+                for (const auto& d : drones) {
+                    for (const auto& s : d.path()) g.lastVisitTime[g.idx(s.x, s.y)] = -1;
+                }
+            }
+
+            header.bytes = payload.size();
+            if (!writeAll(resultFd, &header, sizeof(header)) ||
+                !writeAll(resultFd, payload.data(), payload.size())) {
+                break;   // coordinator is gone
+            }
+        }
+    } catch (...) {
+        code = 2;
+    }
+    ::close(taskFd);
+    ::close(resultFd);
+    ::_exit(code);   // never run the parent's destructors or atexit handlers
+}
+
+void BatchCoordinator::stopWorkers() noexcept {
+    for (auto& w : m_live) {
+        closeFd(w.taskFd);
+        closeFd(w.resultFd);
+        if (w.pid > 0) {
+            ::kill(w.pid, SIGKILL);
+            ::waitpid(w.pid, nullptr, 0);
+            w.pid = -1;
+        }
+    }
+    m_live.clear();
+}
+
+BatchReport BatchCoordinator::run(const std::vector<Scenario>& scenarios) {
+    BatchReport report;
+    report.outcomes.resize(scenarios.size());
+    for (std::size_t i = 0; i < scenarios.size(); ++i) {
+        report.outcomes[i].scenario = static_cast<int>(i);
+    }
+    if (scenarios.empty()) return report;
+
+    // A worker that dies turns our next write to it into EPIPE, not a signal.
+    struct SigpipeGuard {
+        void (*previous)(int) = std::signal(SIGPIPE, SIG_IGN);
+        ~SigpipeGuard() { std::signal(SIGPIPE, previous); }
+    } sigpipeGuard;
+
+    std::size_t next = 0;
+    auto dispatch = [&](Worker& w) {
+        if (next >= scenarios.size()) {
+            closeFd(w.taskFd);   // the worker exits once its input ends
+            return;
+        }
+        w.busyWith = static_cast<int>(next++);
+        const std::int32_t index = w.busyWith;
+        // A failed write means the worker died; its result pipe reports it.
+        (void)writeAll(w.taskFd, &index, sizeof(index));
+    };
+
+    const std::size_t count = std::min<std::size_t>(static_cast<std::size_t>(m_workers), scenarios.size());
+    try {
+        for (std::size_t i = 0; i < count; ++i) {
+            m_live.push_back(spawnWorker(scenarios));
+            dispatch(m_live.back());
+        }
+
+        std::vector<pollfd> fds;
+        std::vector<std::size_t> owner;
+        for (;;) {
+            fds.clear();
+            owner.clear();
+            for (std::size_t i = 0; i < m_live.size(); ++i) {
+                if (m_live[i].resultFd < 0) continue;
+                fds.push_back(pollfd{ m_live[i].resultFd, POLLIN, 0 });
+                owner.push_back(i);
+            }
+            if (fds.empty()) break;
+            if (::poll(fds.data(), fds.size(), -1) < 0) {
+                if (errno == EINTR) continue;
+                throw BatchError(std::string("poll failed: ") + std::strerror(errno));
+            }
+
+            for (std::size_t k = 0; k < fds.size(); ++k) {
+                if (fds[k].revents == 0) continue;
+                // Index, not reference: a respawn below appends to m_live.
+                const std::size_t wi = owner[k];
+
+                FrameHeader header{};
+                std::string payload;
+                bool framed = readAll(m_live[wi].resultFd, &header, sizeof(header));
+                if (framed) {
+                    payload.resize(header.bytes);
+                    framed = readAll(m_live[wi].resultFd, payload.data(), payload.size());
+                }
+                if (framed && header.scenario == m_live[wi].busyWith) {
+                    auto& out = report.outcomes[static_cast<std::size_t>(header.scenario)];
+                    if (header.status == kOk) {
+                        try {
+                            out.result = decode(payload);
+                            out.ok     = true;
+                        } catch (const std::exception& e) {
+                            out.error = e.what();
+                        }
+                    } else {
+                        out.error = std::move(payload);
+                    }
+                    m_live[wi].busyWith = -1;
+                    dispatch(m_live[wi]);
+                    continue;
+                }
+
+                // End of stream: the worker finished or died. A frame for the
+                // wrong scenario means it is confused; stop it the same way.
+                Worker& w = m_live[wi];
+                if (framed) ::kill(w.pid, SIGKILL);
+                closeFd(w.resultFd);
+                closeFd(w.taskFd);
+                int status = 0;
+                ::waitpid(w.pid, &status, 0);
+                w.pid = -1;
+                const int lost = std::exchange(w.busyWith, -1);
+                if (lost >= 0) {
+                    report.outcomes[static_cast<std::size_t>(lost)].error =
+                        "scenario " + std::to_string(lost) + ": " + describeExit(status);
+                    if (next < scenarios.size()) {
+                        m_live.push_back(spawnWorker(scenarios));
+                        dispatch(m_live.back());
+                    }
+                }
+            }
+        }
+    } catch (...) {
+        stopWorkers();
+        throw;
+    }
+    m_live.clear();
+
+    for (const auto& o : report.outcomes) {
+        if (o.ok) report.totalScore += o.result.totalScore;
+        else      ++report.failed;
+    }
+    return report;
+}
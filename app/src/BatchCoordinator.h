@@ -0,0 +1,54 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include "RunConfig.h"
+#include "struct/Grid.h"
+#include "struct/ParamBlock.h"
+#include "struct/Result.h"
+
+// One planning job of a batch: a planner, its settings and the drone starts.
+// Scenarios share the map (and so the loader settings it was loaded with).
+using Scenario = RunConfig;
+
+// Runs scenarios in forked worker processes that share one read-only copy
+// of the map. A grid loaded with GridStorageConfig::sharedMap already keeps
+// base and inc in shared memory and is only made read-only; any other grid
+// is copied into a shared memory object (peak 1.5x the map while copying).
+// Each worker only allocates its own visit times.
+// Scenarios are handed out one at a time over per-worker pipes, so a slow
+// scenario does not hold up the rest. A worker that crashes fails only the
+// scenario it was running and is replaced.
+class BatchCoordinator {
+public:
+    BatchCoordinator(std::unique_ptr<Grid> grid, ParamSections params, int workers);
+    ~BatchCoordinator();
+
+    BatchCoordinator(const BatchCoordinator&) = delete;
+    BatchCoordinator& operator=(const BatchCoordinator&) = delete;
+
+    // Throws std::runtime_error if workers cannot be started at all.
+    [[nodiscard]] BatchReport run(const std::vector<Scenario>& scenarios);
+
+    [[nodiscard]] const Grid& grid() const noexcept { return *m_grid; }
+
+private:
+    struct Worker {
+        pid_t pid      = -1;
+        int   taskFd   = -1;   // coordinator -> worker: scenario indices
+        int   resultFd = -1;   // worker -> coordinator: framed results
+        int   busyWith = -1;   // scenario in flight, or -1
+    };
+
+    void   shareGrid();
+    void   stopWorkers() noexcept;
+    Worker spawnWorker(const std::vector<Scenario>& scenarios);
+    [[noreturn]] void workerMain(int taskFd, int resultFd, const std::vector<Scenario>& scenarios);
+
+    std::unique_ptr<Grid> m_grid;
+    ParamSections         m_params;
+    int                   m_workers;
+    int                   m_shmFd = -1;
+    std::vector<Worker>   m_live;
+};
@@ -1,16 +1,30 @@
 #include "CLIOptions.h"
+#include <algorithm>
 #include <fstream>
+#include <iterator>
 #include <sstream>
 #include <stdexcept>
+#include <string_view>
+#include "PlannerRegistry.h"
 
 namespace {
-    int toInt(const std::string& who, const std::string& s) {
-        try { return std::stoi(s); }
-        catch (...) { throw std::runtime_error(who + " expects integer, got '" + s + "'"); }
+    // [algo.<planner>] or [loader.<loader>] naming a registered one
+    bool knownSection(std::string_view section) {
+        constexpr std::string_view kAlgo = "algo.", kLoader = "loader.";
+        if (section.starts_with(kAlgo))   return PlannerRegistry::instance().find(section.substr(kAlgo.size())) != nullptr;
+        if (section.starts_with(kLoader)) return LoaderRegistry::instance().find(section.substr(kLoader.size())) != nullptr;
+        return false;
     }
-    double toDouble(const std::string& who, const std::string& s) {
-        try { return std::stod(s); }
-        catch (...) { throw std::runtime_error(who + " expects floating point, got '" + s + "'"); }
+
+    // Issues about command-line settings read "--steps must be ..."
+    std::string formatCliIssues(const std::vector<ConfigIssue>& issues) {
+        std::string out;
+        for (const auto& i : issues) {
+            if (!out.empty()) out += '\n';
+            if (!i.key.empty()) out += "--" + i.key + " ";
+            out += i.message;
+        }
+        return out;
     }
 }
 
@@ -27,7 +41,10 @@ bool CLIOptions::parseCLI() {
         }
     }
 
-    // pass 2: args
+    // pass 2: args. Malformed values are collected, not thrown, so they are
+    // reported together with everything else that is wrong.
+    std::vector<ConfigIssue> issues;
+    bool startsFromCli = false;   // command-line --start replaces config ones
     for (int i = 1; i < argc; ++i) {
         std::string a = argv[i];
         auto needValue = [&](const std::string& name) -> std::string {
@@ -37,16 +54,57 @@ bool CLIOptions::parseCLI() {
             }
             return std::string(argv[++i]);
         };
+        auto bad = [&](const std::string& val, const char* expected) {
+            issues.push_back(ConfigIssue{ 0, a.substr(2), std::string("expects ") + expected + ", got '" + val + "'" });
+        };
+        auto asInt = [&](int& out) {
+            const std::string val = needValue(a);
+            if (!config::parseInt(config::trim(val), out)) bad(val, "an integer");
+        };
 
         if (a == "--file")               m_filePath     = needValue(a);
-        else if (a == "--steps")         m_totalSteps   = toInt(a, needValue(a));
-        else if (a == "--time_ms")       m_timeBudgetMs = toInt(a, needValue(a));
-        else if (a == "--start_x")       m_startX       = toInt(a, needValue(a));
-        else if (a == "--start_y")       m_startY       = toInt(a, needValue(a));
-        else if (a == "--regrowth_rate") m_regrowthRate = toDouble(a, needValue(a));
-        else if (a == "--horizon")       m_horizon      = toInt(a, needValue(a));
+        else if (a == "--steps")         asInt(m_totalSteps);
+        else if (a == "--time_ms")       asInt(m_timeBudgetMs);
+        else if (a == "--start_x")       asInt(m_startX);
+        else if (a == "--start_y")       asInt(m_startY);
+        else if (a == "--start") {
+            if (!startsFromCli) m_starts.clear();
+            startsFromCli = true;
+            const std::string val = needValue(a);
+            Position p{};
+            if (config::parsePosition(val, p)) m_starts.push_back(p);
+            else bad(val, "x,y");
+        }
+        else if (a == "--regrowth_rate") {
+            const std::string val = needValue(a);
+            if (!config::parseDouble(config::trim(val), m_regrowthRate)) bad(val, "a number");
+        }
+        else if (a == "--horizon")       asInt(m_horizon);
+        else if (a == "--step_deadline_us") asInt(m_stepDeadlineUs);
         else if (a == "--no-stay")       m_allowStay    = false;
         else if (a == "--allow-stay")    m_allowStay    = true;
+        else if (a == "--padded")        m_padded       = true;
+        else if (a == "--layout") {
+            const std::string val = needValue(a);
+            if (!config::parseLayout(val, m_layout)) bad(val, "rowmajor or tiled");
+        }
+        else if (a == "--huge_pages") {
+            const std::string val = needValue(a);
+            if (!config::parseHugePages(val, m_hugePages)) bad(val, "off, thp or explicit");
+        }
+        else if (a == "--first_touch_threads") asInt(m_firstTouchThreads);
+        else if (a == "--checkpoint")    m_checkpointPath  = needValue(a);
+        else if (a == "--checkpoint_every") asInt(m_checkpointEvery);
+        else if (a == "--resume")        m_resumePath      = needValue(a);
+        else if (a == "--pipeline")      m_pipeline     = true;
+        else if (a == "--profile")       m_profile      = true;
+        else if (a == "--validate")      m_validate     = true;
+        else if (a == "--summary")       m_summary      = true;
+        else if (a == "--scenarios")     m_scenariosPath = needValue(a);
+        else if (a == "--workers")       asInt(m_workers);
+        else if (a == "--algo")          m_algoName     = needValue(a);
+        else if (a == "--loader")        m_loaderName   = needValue(a);
+        else if (a == "--param")         addParam(needValue(a));
         else if (a == "--config")        { ++i; continue; }
         else if (a == "-h" || a == "--help") {
             return false;
@@ -59,76 +117,175 @@ bool CLIOptions::parseCLI() {
         }
     }
 
-    // Required
-    if (m_filePath.empty())  
+    if (m_checkpointEvery > 0 && m_checkpointPath.empty())
     {
-        throw std::runtime_error("Missing required option: --file <path>");
+        // Keep checkpointing into the file we resumed from.
+        m_checkpointPath = m_resumePath;
     }
-    if (m_totalSteps <= 0)   
+
+    // Check everything and report all problems at once.
+    const std::size_t malformed = issues.size();
+    if (m_filePath.empty())
     {
-        throw std::runtime_error("--steps must be a positive integer");
+        issues.push_back(ConfigIssue{ 0, {}, "Missing required option: --file <path>" });
     }
-    if (m_timeBudgetMs <= 0) 
+    RunConfigDraft draft;
+    draft.algo       = m_algoName;
+    draft.cfg        = GridAlgoConfig{ m_totalSteps, m_timeBudgetMs, m_horizon, m_allowStay, m_stepDeadlineUs,
+                                       m_summary };
+    draft.starts     = startPositions();
+    draft.loaderName = m_loaderName;
+    draft.loader     = GridLoaderConfig{ m_filePath, m_regrowthRate,
+                                         GridStorageConfig{ m_padded, m_layout, m_hugePages, m_firstTouchThreads } };
+    m_run = draft.build(issues);
+    if (m_checkpointEvery < 0)
     {
-        throw std::runtime_error("--time_ms must be a positive integer (milliseconds)");
+        issues.push_back(ConfigIssue{ 0, "checkpoint_every", "must be >= 0" });
     }
-
-    // Ranges
-    if (m_horizon < 1 || m_horizon > 2)
+    if (m_checkpointEvery > 0 && m_checkpointPath.empty())
+    {
+        issues.push_back(ConfigIssue{ 0, "checkpoint_every", "requires --checkpoint <path>" });
+    }
+    if (m_checkpointEvery == 0 && !m_checkpointPath.empty())
+    {
+        issues.push_back(ConfigIssue{ 0, "checkpoint", "requires --checkpoint_every <steps>" });
+    }
+    for (const auto& [section, block] : m_params)
+    {
+        // A misspelt section would otherwise drop its settings silently.
+        if (!knownSection(section))
+        {
+            issues.push_back(ConfigIssue{ 0, {}, "unknown parameter section [" + section +
+                                                 "]: no registered planner (algo.<name>) or loader (loader.<name>)" });
+        }
+    }
+    if (m_workers < 0)
+    {
+        issues.push_back(ConfigIssue{ 0, "workers", "must be >= 0" });
+    }
+    if (!m_scenariosPath.empty() && (m_checkpointEvery > 0 || !m_resumePath.empty() || m_pipeline))
     {
-        throw std::runtime_error("--horizon must be 1 or 2");
+        issues.push_back(ConfigIssue{ 0, "scenarios", "cannot be combined with --checkpoint_every, --resume or --pipeline" });
     }
-    if (m_regrowthRate < 0.0 || m_regrowthRate > 1.0)
+    if (m_summary && (m_checkpointEvery > 0 || !m_resumePath.empty() || m_validate))
     {
-        throw std::runtime_error("--regrowth_rate must be in [0.0, 1.0]");
+        // Checkpoints and validation are built from the drone paths.
+        issues.push_back(ConfigIssue{ 0, "summary", "cannot be combined with --checkpoint_every, --resume or --validate" });
+    }
+    if (!issues.empty())
+    {
+        // A value that did not parse is reported once, not again as out of range.
+        const auto first = issues.begin() + static_cast<std::ptrdiff_t>(malformed);
+        issues.erase(std::remove_if(first, issues.end(), [&](const ConfigIssue& i) {
+                         return std::any_of(issues.begin(), first, [&](const ConfigIssue& m) { return m.key == i.key; });
+                     }), issues.end());
+        m_run.reset();
+        throw std::runtime_error(formatCliIssues(issues));
     }
 
     return true;
 }
 
-bool CLIOptions::parseBool(const std::string& s) {
-    return s == "1" || s == "true" || s == "TRUE" || s == "True" || s == "yes";
+std::vector<Position> CLIOptions::startPositions() const {
+    if (m_starts.empty()) return { Position{ m_startX, m_startY } };
+    return m_starts;
+}
+
+const RunConfig& CLIOptions::runConfig() const {
+    if (!m_run)
+    {
+        throw std::logic_error("CLIOptions::runConfig() before a successful parseCLI()");
+    }
+    return *m_run;
+}
+
+// "<section>.<key>=<value>", e.g. "algo.greedy.foo=1"; the section is
+// everything before the last '.' of the left-hand side.
+void CLIOptions::addParam(const std::string& spec) {
+    const auto eq  = spec.find('=');
+    const auto dot = spec.rfind('.', eq);
+    if (eq == std::string::npos || dot == std::string::npos || dot == 0 || dot + 1 >= eq) {
+        throw std::runtime_error("--param expects <section>.<key>=<value>, got '" + spec + "'");
+    }
+    m_params[spec.substr(0, dot)][spec.substr(dot + 1, eq - dot - 1)] = spec.substr(eq + 1);
 }
 
+// Reads the whole file and reports every bad value in one error.
 void CLIOptions::loadConfigFile(const std::string& path) {
-    std::ifstream in(path);
+    std::ifstream in(path, std::ios::binary);
     if (!in) 
     {
         throw std::runtime_error("Failed to open config file: " + path);
     }
-    std::string line;
-    while (std::getline(in, line)) 
+    const std::string content{ std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() };
+
+    std::vector<ConfigIssue> issues;
+    std::string_view text = content;
+    std::string section; // "" until the first [section] header
+    for (int lineNo = 1; !text.empty(); ++lineNo)
     {
-        auto l = line.find_first_not_of("\t \r\n");
-        auto r = line.find_last_not_of("\t \r\n");
-        if (l == std::string::npos) {
+        const auto eol = text.find('\n');
+        const std::string_view line = config::trim(text.substr(0, eol));
+        text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+        if (line.empty() || line[0] == '#') {
             continue;
         }
-        std::string trimmed = line.substr(l, r - l + 1);
-        if (trimmed.empty() || trimmed[0] == '#') {
+        if (line.front() == '[' && line.back() == ']') {
+            section = line.substr(1, line.size() - 2);
             continue;
         }
-        auto eq = trimmed.find('=');
-        if (eq == std::string::npos) {
+        const auto eq = line.find('=');
+        if (eq == std::string_view::npos) {
             continue;
         }
-        std::string key = trimmed.substr(0, eq);
-        std::string val = trimmed.substr(eq + 1);
-        auto l2 = key.find_first_not_of("\t \r\n");
-        auto r2 = key.find_last_not_of("\t \r\n");
-        key = key.substr(l2, r2 - l2 + 1);
-        auto l3 = val.find_first_not_of("\t \r\n");
-        auto r3 = val.find_last_not_of("\t \r\n");
-        val = val.substr(l3, r3 - l3 + 1);
+        const std::string_view key = config::trim(line.substr(0, eq));
+        const std::string_view val = config::trim(line.substr(eq + 1));
+
+        if (!section.empty()) {
+            m_params[section][std::string(key)] = val;
+            continue;
+        }
+
+        auto bad = [&](const char* expected) {
+            issues.push_back(ConfigIssue{ lineNo, std::string(key),
+                                          std::string("expects ") + expected + ", got '" + std::string(val) + "'" });
+        };
+        auto asInt  = [&](int& out)    { if (!config::parseInt(val, out))    bad("an integer"); };
+        auto asBool = [&](bool& out)   { if (!config::parseBool(val, out))   bad("a boolean"); };
 
         if      (key == "file")          m_filePath     = val;
-        else if (key == "steps")         m_totalSteps   = toInt("steps", val);
-        else if (key == "time_ms")       m_timeBudgetMs = toInt("time_ms", val);
-        else if (key == "start_x")       m_startX       = toInt("start_x", val);
-        else if (key == "start_y")       m_startY       = toInt("start_y", val);
-        else if (key == "regrowth_rate") m_regrowthRate = toDouble("regrowth_rate", val);
-        else if (key == "horizon")       m_horizon      = toInt("horizon", val);
-        else if (key == "allow_stay")    m_allowStay    = parseBool(val);
+        else if (key == "steps")         asInt(m_totalSteps);
+        else if (key == "time_ms")       asInt(m_timeBudgetMs);
+        else if (key == "start_x")       asInt(m_startX);
+        else if (key == "start_y")       asInt(m_startY);
+        else if (key == "start") {
+            Position p{};
+            if (config::parsePosition(val, p)) m_starts.push_back(p);
+            else bad("x,y");
+        }
+        else if (key == "regrowth_rate") { if (!config::parseDouble(val, m_regrowthRate)) bad("a number"); }
+        else if (key == "horizon")       asInt(m_horizon);
+        else if (key == "allow_stay")    asBool(m_allowStay);
+        else if (key == "step_deadline_us") asInt(m_stepDeadlineUs);
+        else if (key == "padded")        asBool(m_padded);
+        else if (key == "layout")        { if (!config::parseLayout(val, m_layout)) bad("rowmajor or tiled"); }
+        else if (key == "huge_pages")    { if (!config::parseHugePages(val, m_hugePages)) bad("off, thp or explicit"); }
+        else if (key == "first_touch_threads") asInt(m_firstTouchThreads);
+        else if (key == "checkpoint")    m_checkpointPath  = val;
+        else if (key == "checkpoint_every") asInt(m_checkpointEvery);
+        else if (key == "resume")        m_resumePath      = val;
+        else if (key == "pipeline")      asBool(m_pipeline);
+        else if (key == "profile")       asBool(m_profile);
+        else if (key == "validate")      asBool(m_validate);
+        else if (key == "summary")       asBool(m_summary);
+        else if (key == "scenarios")     m_scenariosPath = val;
+        else if (key == "workers")       asInt(m_workers);
+        else if (key == "algo")          m_algoName     = val;
+        else if (key == "loader")        m_loaderName   = val;
+    }
+    if (!issues.empty())
+    {
+        throw std::runtime_error("Invalid config file:\n" + formatIssues(issues, path));
     }
 }
 
@@ -136,7 +293,13 @@ std::string CLIOptions::usage(const char* argv0) {
     std::ostringstream ss;
     ss << "Usage:\n"
        << "  " << argv0 << " --file <path> --steps <t> --time_ms <T> --start_x <x> --start_y <y>\n"
-       << "               [--regrowth_rate <r>] [--horizon <1|2>] [--allow-stay|--no-stay] [--config <cfg>]\n\n"
+       << "               [--start <x>,<y> ...]\n"
+       << "               [--regrowth_rate <r>] [--horizon <1|2>] [--allow-stay|--no-stay] [--config <cfg>]\n"
+       << "               [--padded] [--layout <rowmajor|tiled>] [--huge_pages <off|thp|explicit>]\n"
+       << "               [--first_touch_threads <n>] [--step_deadline_us <us>]\n"
+       << "               [--checkpoint <path> --checkpoint_every <steps>] [--resume <path>]\n"
+       << "               [--pipeline] [--profile] [--validate] [--summary] [--scenarios <file> [--workers <n>]]\n"
+       << "               [--algo <name|auto>] [--loader <name>] [--param <section>.<key>=<value>]\n\n"
        << "Input file format:\n"
        << "  First line: N (grid size)\n"
        << "  Next N lines: N integers per line (initial cell scores)\n";
@@ -150,8 +313,26 @@ Options CLIOptions::toOptions() const {
         /*timeBudgetMs*/ m_timeBudgetMs,
         /*startX*/       m_startX,
         /*startY*/       m_startY,
+        /*starts*/       startPositions(),
         /*regrowthRate*/ m_regrowthRate,
         /*horizon*/      m_horizon,
-        /*allowStay*/    m_allowStay
+        /*allowStay*/    m_allowStay,
+        /*stepDeadlineUs*/ m_stepDeadlineUs,
+        /*padded*/       m_padded,
+        /*layout*/       m_layout,
+        /*hugePages*/    m_hugePages,
+        /*firstTouchThreads*/ m_firstTouchThreads,
+        /*checkpoint*/   std::filesystem::path{m_checkpointPath},
+        /*checkpointEvery*/ m_checkpointEvery,
+        /*resume*/       std::filesystem::path{m_resumePath},
+        /*pipeline*/     m_pipeline,
+        /*profile*/      m_profile,
+        /*validate*/     m_validate,
+        /*summary*/      m_summary,
+        /*scenarios*/    std::filesystem::path{m_scenariosPath},
+        /*workers*/      m_workers,
+        /*algo*/         m_algoName,
+        /*loader*/       m_loaderName,
+        /*params*/       m_params
     };
 }
@@ -2,6 +2,12 @@
 
 #include <string>
 #include <filesystem>
+#include <optional>
+#include <vector>
+#include "RunConfig.h"
+#include "struct/Position.h"
+#include "struct/ParamBlock.h"
+#include "struct/GridStorageConfig.h"
 
 struct Options {
     std::filesystem::path file;
@@ -9,9 +15,27 @@ struct Options {
     int timeBudgetMs;
     int startX;
     int startY;
+    std::vector<Position> starts;       // one per drone
     double regrowthRate; // [0.0, 1.0]
     int horizon;         // 1 or 2
     bool allowStay;
+    int stepDeadlineUs;  // per-step planning deadline; 0 = none
+    bool padded;         // sentinel-padded grid storage
+    GridLayout layout;
+    HugePages hugePages;
+    int firstTouchThreads;
+    std::filesystem::path checkpoint;   // empty = no checkpoints
+    int checkpointEvery;                // steps between checkpoints
+    std::filesystem::path resume;       // empty = fresh run
+    bool pipeline;       // overlap load, planning and output
+    bool profile;        // phase timings on stderr
+    bool validate;       // re-simulate the result before printing it
+    bool summary;        // aggregate statistics instead of paths
+    std::filesystem::path scenarios;    // non-empty = batch mode
+    int workers;                        // batch worker processes; 0 = one per core
+    std::string algo;    // planner registry name, or "auto"
+    std::string loader;  // loader registry name
+    ParamSections params;
 };
 
 class CLIOptions {
@@ -31,9 +55,30 @@ public:
     [[nodiscard]] int    timeBudgetMs() const noexcept { return m_timeBudgetMs; }
     [[nodiscard]] int    startX()       const noexcept { return m_startX; }
     [[nodiscard]] int    startY()       const noexcept { return m_startY; }
+    // One per drone: the --start list, or (start_x, start_y) if none given
+    [[nodiscard]] std::vector<Position> startPositions() const;
     [[nodiscard]] double regrowthRate() const noexcept { return m_regrowthRate; }
     [[nodiscard]] int    horizon()      const noexcept { return m_horizon; }
     [[nodiscard]] bool   allowStay()    const noexcept { return m_allowStay; }
+    [[nodiscard]] bool   padded()       const noexcept { return m_padded; }
+    [[nodiscard]] GridLayout layout()   const noexcept { return m_layout; }
+    [[nodiscard]] HugePages  hugePages() const noexcept { return m_hugePages; }
+    [[nodiscard]] int    firstTouchThreads() const noexcept { return m_firstTouchThreads; }
+    [[nodiscard]] const std::string& checkpointPath() const noexcept { return m_checkpointPath; }
+    [[nodiscard]] int    checkpointEvery() const noexcept { return m_checkpointEvery; }
+    [[nodiscard]] const std::string& resumePath() const noexcept { return m_resumePath; }
+    [[nodiscard]] bool   pipeline()     const noexcept { return m_pipeline; }
+    [[nodiscard]] bool   profile()      const noexcept { return m_profile; }
+    [[nodiscard]] bool   validate()     const noexcept { return m_validate; }
+    [[nodiscard]] bool   summary()      const noexcept { return m_summary; }
+    [[nodiscard]] const std::string& scenariosPath() const noexcept { return m_scenariosPath; }
+    [[nodiscard]] int    workers()      const noexcept { return m_workers; }
+    [[nodiscard]] const std::string&   algoName()   const noexcept { return m_algoName; }
+    [[nodiscard]] const std::string&   loaderName() const noexcept { return m_loaderName; }
+    [[nodiscard]] const ParamSections& params()     const noexcept { return m_params; }
+
+    // The validated run settings; only valid after parseCLI() returned true.
+    [[nodiscard]] const RunConfig& runConfig() const;
 
     [[nodiscard]] Options toOptions() const;
 
@@ -42,14 +87,33 @@ private:
     char** argv = nullptr;
 
     void        loadConfigFile(const std::string& path);
-    static bool parseBool(const std::string& s);
+    void        addParam(const std::string& spec);
 
     std::string m_filePath;
     int    m_totalSteps   = -1;
     int    m_timeBudgetMs = -1;
     int    m_startX       = 0;
     int    m_startY       = 0;
+    std::vector<Position> m_starts;
     double m_regrowthRate = 0.0;
     int    m_horizon      = 2;
     bool   m_allowStay    = true;
+    int    m_stepDeadlineUs = 0;
+    bool   m_padded       = false;
+    GridLayout m_layout   = GridLayout::RowMajor;
+    HugePages  m_hugePages = HugePages::Off;
+    int    m_firstTouchThreads = 1;
+    std::string m_checkpointPath;
+    int    m_checkpointEvery = 0;
+    std::string m_resumePath;
+    bool   m_pipeline     = false;
+    bool   m_profile      = false;
+    bool   m_validate     = false;
+    bool   m_summary      = false;
+    std::string m_scenariosPath;
+    int    m_workers      = 0;
+    std::string   m_algoName   = "greedy";
+    std::string   m_loaderName = "text";
+    ParamSections m_params;
+    std::optional<RunConfig> m_run;
 };
@@ -0,0 +1,301 @@
+#include "Checkpoint.h"
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "struct/Drone.h"
+#include "struct/Grid.h"
+struct CheckpointError : std::runtime_error { using std::runtime_error::runtime_error; };
+
+namespace {
+
+constexpr char          kMagic[4] = { 'D', 'S', 'C', 'K' };
+constexpr std::uint32_t kVersion  = 2;
+
+template <class T>
+void put(std::ostream& out, const T& v) {
+    out.write(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+template <class T>
+T get(std::istream& in) {
+    T v{};
+    if (!in.read(reinterpret_cast<char*>(&v), sizeof(T))) {
+        throw CheckpointError("truncated checkpoint");
+    }
+    return v;
+}
+
+// Element counts are bounded by what the remaining file could hold, so a
+// corrupt length cannot trigger a huge allocation.
+std::uint64_t getCount(std::istream& in, std::uint64_t remaining, std::size_t elemSize) {
+    const auto n = get<std::uint64_t>(in);
+    if (n > remaining / elemSize) throw CheckpointError("corrupt checkpoint (bad length)");
+    return n;
+}
+
+void putString(std::ostream& out, const std::string& s) {
+    put<std::uint64_t>(out, s.size());
+    out.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+std::string getString(std::istream& in, std::uint64_t remaining) {
+    std::string s(getCount(in, remaining, 1), '\0');
+    if (!in.read(s.data(), static_cast<std::streamsize>(s.size()))) throw CheckpointError("truncated checkpoint");
+    return s;
+}
+
+std::uint64_t cellKey(int x, int y) noexcept {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(y)) << 32)
+         | static_cast<std::uint32_t>(x);
+}
+
+} // namespace
+
+ParamBlock plannerParams(const ParamSections& params) {
+    constexpr std::string_view kAlgo = "algo.";
+    ParamBlock out;
+    for (const auto& [section, block] : params) {
+        if (!section.starts_with(kAlgo)) continue;
+        for (const auto& [key, value] : block) out[section.substr(kAlgo.size()) + "." + key] = value;
+    }
+    return out;
+}
+
+std::uint64_t mapHash(const Grid& grid) {
+    std::uint64_t h = 1469598103934665603ull;
+    auto mix = [&h](CellValue v) {
+        for (int i = 0; i < 4; ++i) {
+            h ^= static_cast<std::uint64_t>(static_cast<std::uint32_t>(v) >> (8 * i)) & 0xffu;
+            h *= 1099511628211ull;
+        }
+    };
+    for (int y = 0; y < grid.N; ++y) {
+        for (int x = 0; x < grid.N; ++x) {
+            const std::size_t k = grid.idx(x, y);
+            mix(grid.base[k]);
+            mix(grid.inc[k]);
+        }
+    }
+    return h;
+}
+
+void saveCheckpoint(const std::filesystem::path& path, const Checkpoint& cp) {
+    auto tmp = path;
+    tmp += ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) throw CheckpointError("Failed to open checkpoint for writing: " + tmp.string());
+
+        out.write(kMagic, sizeof(kMagic));
+        put(out, kVersion);
+        put<std::int32_t>(out, cp.gridN);
+        put<std::int32_t>(out, cp.horizon);
+        put<std::uint8_t>(out, cp.allowStay ? 1 : 0);
+        put<std::int32_t>(out, cp.stepDeadlineUs);
+        put<double>(out, cp.run.regrowthRate);
+        putString(out, cp.run.planner);
+        put<std::uint64_t>(out, cp.run.plannerParams.size());
+        for (const auto& [key, value] : cp.run.plannerParams) {
+            putString(out, key);
+            putString(out, value);
+        }
+        put<std::uint64_t>(out, cp.mapHash);
+        put<std::int32_t>(out, cp.step);
+        put<std::int64_t>(out, cp.score);
+
+        put<std::uint64_t>(out, cp.drones.size());
+        for (const auto& d : cp.drones) {
+            put<std::int32_t>(out, d.droneId);
+            put<std::int32_t>(out, d.start.x);
+            put<std::int32_t>(out, d.start.y);
+            put<std::uint64_t>(out, d.path.size());
+            out.write(reinterpret_cast<const char*>(d.path.data()),
+                      static_cast<std::streamsize>(d.path.size() * sizeof(Step)));
+        }
+
+        put<std::uint64_t>(out, cp.visits.size());
+        out.write(reinterpret_cast<const char*>(cp.visits.data()),
+                  static_cast<std::streamsize>(cp.visits.size() * sizeof(CellVisit)));
+
+        out.flush();
+        if (!out) throw CheckpointError("Failed to write checkpoint: " + tmp.string());
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) throw CheckpointError("Failed to publish checkpoint " + path.string() + ": " + ec.message());
+}
+
+Checkpoint loadCheckpoint(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw CheckpointError("Failed to open checkpoint: " + path.string());
+    std::error_code ec;
+    const auto fileSize = std::filesystem::file_size(path, ec);
+    if (ec) throw CheckpointError("Failed to stat checkpoint: " + path.string());
+
+    try {
+        char magic[4];
+        if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+            throw CheckpointError("not a checkpoint file");
+        }
+        if (get<std::uint32_t>(in) != kVersion) throw CheckpointError("unsupported checkpoint version");
+
+        Checkpoint cp;
+        cp.gridN     = get<std::int32_t>(in);
+        cp.horizon   = get<std::int32_t>(in);
+        cp.allowStay = get<std::uint8_t>(in) != 0;
+        cp.stepDeadlineUs   = get<std::int32_t>(in);
+        cp.run.regrowthRate = get<double>(in);
+        cp.run.planner      = getString(in, fileSize);
+        const auto params = getCount(in, fileSize, 2 * sizeof(std::uint64_t));
+        for (std::uint64_t i = 0; i < params; ++i) {
+            std::string key = getString(in, fileSize);
+            cp.run.plannerParams[std::move(key)] = getString(in, fileSize);
+        }
+        cp.mapHash   = get<std::uint64_t>(in);
+        cp.step      = get<std::int32_t>(in);
+        cp.score     = get<std::int64_t>(in);
+
+        const auto droneCount = getCount(in, fileSize, 3 * sizeof(std::int32_t));
+        cp.drones.resize(droneCount);
+        for (auto& d : cp.drones) {
+            d.droneId = get<std::int32_t>(in);
+            d.start.x = get<std::int32_t>(in);
+            d.start.y = get<std::int32_t>(in);
+            d.path.resize(getCount(in, fileSize, sizeof(Step)));
+            if (!in.read(reinterpret_cast<char*>(d.path.data()),
+                         static_cast<std::streamsize>(d.path.size() * sizeof(Step)))) {
+                throw CheckpointError("truncated checkpoint");
+            }
+        }
+
+        cp.visits.resize(getCount(in, fileSize, sizeof(CellVisit)));
+        if (!in.read(reinterpret_cast<char*>(cp.visits.data()),
+                     static_cast<std::streamsize>(cp.visits.size() * sizeof(CellVisit)))) {
+            throw CheckpointError("truncated checkpoint");
+        }
+        return cp;
+    } catch (const CheckpointError& e) {
+        throw CheckpointError("While reading checkpoint '" + path.string() + "': " + e.what());
+    }
+}
+
+CheckpointWriter::CheckpointWriter(std::filesystem::path path, Checkpoint base,
+                                   std::shared_future<std::uint64_t> mapHash)
+    : m_path(std::move(path))
+    , m_state(std::move(base))
+    , m_mapHash(std::move(mapHash))
+{
+    m_visitSlot.reserve(m_state.visits.size());
+    for (std::size_t i = 0; i < m_state.visits.size(); ++i) {
+        m_visitSlot.emplace(cellKey(m_state.visits[i].x, m_state.visits[i].y), i);
+    }
+    m_sent.reserve(m_state.drones.size());
+    for (const auto& d : m_state.drones) m_sent.push_back(d.path.size());
+
+    m_worker = std::thread([this] { workerLoop(); });
+}
+
+CheckpointWriter::~CheckpointWriter() {
+    try {
+        finish();
+    } catch (...) {
+        // Errors are reported through finish(); never throw from a destructor.
+    }
+}
+
+void CheckpointWriter::onStep(int tNow, long long totalScore, std::span<const Drone> drones) {
+    const auto t0 = std::chrono::steady_clock::now();
+
+    Delta delta;
+    {
+        std::lock_guard lock(m_mutex);
+        if (!m_spare.empty()) {
+            delta = std::move(m_spare.back());
+            m_spare.pop_back();
+        }
+    }
+    delta.step  = tNow;
+    delta.score = totalScore;
+    delta.newSteps.resize(drones.size());
+    for (std::size_t i = 0; i < drones.size() && i < m_sent.size(); ++i) {
+        const auto& path = drones[i].path();
+        delta.newSteps[i].assign(path.begin() + static_cast<std::ptrdiff_t>(m_sent[i]), path.end());
+        m_sent[i] = path.size();
+    }
+    {
+        std::lock_guard lock(m_mutex);
+        m_queue.push_back(std::move(delta));
+    }
+    m_cv.notify_one();
+
+    m_hotPathNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - t0).count();
+}
+
+void CheckpointWriter::finish() {
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_one();
+    if (m_worker.joinable()) m_worker.join();
+    if (m_error) std::rethrow_exception(std::exchange(m_error, nullptr));
+}
+
+void CheckpointWriter::apply(Delta& delta) {
+    for (std::size_t i = 0; i < delta.newSteps.size() && i < m_state.drones.size(); ++i) {
+        auto& path = m_state.drones[i].path;
+        for (const auto& s : delta.newSteps[i]) {
+            path.push_back(s);
+            const auto [it, fresh] = m_visitSlot.try_emplace(cellKey(s.x, s.y), m_state.visits.size());
+            if (fresh) {
+                m_state.visits.push_back(CellVisit{ s.x, s.y, s.timeStep });
+            } else {
+                // Drones are folded one after another, so keep the latest time.
+                auto& t = m_state.visits[it->second].t;
+                if (s.timeStep > t) t = s.timeStep;
+            }
+        }
+    }
+    m_state.step  = delta.step;
+    m_state.score = delta.score;
+}
+
+void CheckpointWriter::workerLoop() {
+    std::vector<Delta> batch;
+    for (;;) {
+        {
+            std::unique_lock lock(m_mutex);
+            m_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+            if (m_queue.empty()) return;   // stopping and drained
+            batch.swap(m_queue);
+        }
+        // Fold everything that queued up while the last file was written and
+        // write the newest state once.
+        for (auto& d : batch) apply(d);
+        {
+            // Hand the buffers back so onStep does not fault in fresh pages.
+            std::lock_guard lock(m_mutex);
+            for (auto& d : batch) {
+                if (m_spare.size() >= 2) break;
+                m_spare.push_back(std::move(d));
+            }
+        }
+        batch.clear();
+        if (m_error) continue;
+        try {
+            if (m_mapHash.valid()) {
+                m_state.mapHash = m_mapHash.get();   // may wait for a pipelined load
+                m_mapHash = {};
+            }
+            saveCheckpoint(m_path, m_state);
+            ++m_written;
+        } catch (...) {
+            m_error = std::current_exception();
+        }
+    }
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <future>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "interfaces/IRunObserver.h"
+#include "struct/ParamBlock.h"
+#include "struct/Position.h"
+#include "struct/Step.h"
+
+class Grid;
+
+// Cell whose last visit is recorded in a checkpoint
+struct CellVisit {
+    int      x;
+    int      y;
+    TimeStep t;
+};
+
+struct DroneCheckpoint {
+    int               droneId;
+    Position          start;
+    std::vector<Step> path;   // every step collected so far; last one is the position
+};
+
+// Run settings outside GridAlgoConfig that a resumed run must share
+struct RunIdentity {
+    std::string planner;         // registry name as given, e.g. "greedy" or "auto"
+    ParamBlock  plannerParams;   // see plannerParams()
+    double      regrowthRate = 0.0;
+
+    bool operator==(const RunIdentity&) const = default;
+};
+
+// Every algo.* parameter of `params`, keyed "<planner>.<key>"
+[[nodiscard]] ParamBlock plannerParams(const ParamSections& params);
+
+// FNV-1a over base and inc of every map cell in row order, so the same map
+// hashes alike in every storage layout
+[[nodiscard]] std::uint64_t mapHash(const Grid& grid);
+
+// Everything needed to continue a run after step `step`: the touched cells
+// of the grid, each drone's path, and the score so far. The settings and the
+// map hash let a resume refuse anything that would not continue the run
+// bit-identically.
+struct Checkpoint {
+    int                          gridN     = 0;
+    int                          horizon   = 1;
+    bool                         allowStay = true;
+    int                          stepDeadlineUs = 0;
+    RunIdentity                  run;
+    std::uint64_t                mapHash   = 0;
+    int                          step      = -1;   // last completed step
+    long long                    score     = 0;
+    std::vector<DroneCheckpoint> drones;
+    std::vector<CellVisit>       visits;
+};
+
+// Writes to `<path>.tmp` and renames over `path`, so a crash mid-write
+// leaves the previous checkpoint intact. Throws std::runtime_error.
+void saveCheckpoint(const std::filesystem::path& path, const Checkpoint& cp);
+[[nodiscard]] Checkpoint loadCheckpoint(const std::filesystem::path& path);
+
+// Periodic checkpointing off the planning thread. onStep only copies the
+// path steps added since the previous call; a background thread folds them
+// into its own copy of the state and writes the file.
+class CheckpointWriter final : public IRunObserver {
+public:
+    // `base` is the checkpoint a resumed run started from, or the empty
+    // initial state (settings, drones with starts). A valid `mapHash` is
+    // waited for on the writer thread and stored in every checkpoint.
+    CheckpointWriter(std::filesystem::path path, Checkpoint base,
+                     std::shared_future<std::uint64_t> mapHash = {});
+    ~CheckpointWriter() override;
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    void onStep(int tNow, long long totalScore, std::span<const Drone> drones) override;
+
+    // Waits for pending writes; rethrows the first write error, if any.
+    void finish();
+
+    // Time spent inside onStep on the planning thread, and snapshots written
+    [[nodiscard]] double hotPathMs() const noexcept { return m_hotPathNs / 1e6; }
+    [[nodiscard]] int    written()   const noexcept { return m_written; }
+
+private:
+    struct Delta {
+        int                            step;
+        long long                      score;
+        std::vector<std::vector<Step>> newSteps;   // per drone
+    };
+
+    void workerLoop();
+    void apply(Delta& delta);
+
+    const std::filesystem::path m_path;
+    Checkpoint                  m_state;          // owned by the worker after start
+    std::shared_future<std::uint64_t> m_mapHash;  // taken before the first write
+    std::unordered_map<std::uint64_t, std::size_t> m_visitSlot; // cell -> index in m_state.visits
+    std::vector<std::size_t>    m_sent;           // per drone: path steps already handed over
+
+    std::mutex                  m_mutex;
+    std::condition_variable     m_cv;
+    std::vector<Delta>          m_queue;
+    std::vector<Delta>          m_spare;          // applied deltas, buffers kept for reuse
+    bool                        m_stop = false;
+    std::exception_ptr          m_error;
+    std::thread                 m_worker;
+
+    long long                   m_hotPathNs = 0;
+    int                         m_written   = 0;
+};
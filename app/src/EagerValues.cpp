@@ -0,0 +1,51 @@
+#include "EagerValues.h"
+
+EagerValues::EagerValues(const Grid& grid, TimeStep t)
+    : m_base(grid.base.data())
+    , m_inc(grid.inc.data())
+    , m_size(grid.base.size())
+    , m_isActive((m_size + kChunk - 1) / kChunk, 0)
+{
+    m_now.allocate(m_size);
+    m_next.allocate(m_size);
+    m_active.reserve(m_isActive.size());   // visit() never reallocates
+    for (std::size_t c = 0; c < m_isActive.size(); ++c) {
+        const std::size_t end = std::min(m_size, (c + 1) * kChunk);
+        bool moving = false;
+        for (std::size_t k = c * kChunk; k < end; ++k) {
+            m_now[k]  = grid.valueAtIndex(k, t);
+            m_next[k] = grid.valueAtIndex(k, t + 1);
+            moving |= m_now[k] != m_next[k];
+        }
+        if (moving) activate(c);
+    }
+}
+
+void EagerValues::tick() noexcept {
+    CellValue* const       now  = m_now.data();
+    CellValue* const       next = m_next.data();
+    const CellValue* const base = m_base;
+    const CellValue* const inc  = m_inc;
+
+    std::size_t kept = 0;
+    for (const std::uint32_t c : m_active) {
+        const std::size_t begin = static_cast<std::size_t>(c) * kChunk;
+        const std::size_t end   = std::min(m_size, begin + kChunk);
+        // Branch-free so it vectorises: full and untouched cells have
+        // next == base and stay put; regrowth saturates at base.
+        int moving = 0;
+        for (std::size_t k = begin; k < end; ++k) {
+            const CellValue n  = next[k];
+            const CellValue nn = n + std::min(inc[k], base[k] - n);
+            now[k]  = n;
+            next[k] = nn;
+            moving |= static_cast<int>(n != nn);
+        }
+        if (moving) {
+            m_active[kept++] = c;
+        } else {
+            m_isActive[c] = 0;
+        }
+    }
+    m_active.resize(kept);
+}
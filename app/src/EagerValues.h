@@ -0,0 +1,58 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "struct/Grid.h"
+
+// Current and next-step value of every storage cell of a Grid, stored
+// explicitly instead of derived from last-visit times on each probe. A bulk
+// tick once per step advances regrowth, but only in chunks that still hold
+// a regrowing cell; a visited cell re-activates its chunk.
+//
+// Agrees exactly with Grid::valueAtIndex as long as every visit goes
+// through visit() and tick() runs once between steps.
+class EagerValues {
+public:
+    // Cells per tick unit: one cache line of each array, contiguous in
+    // storage order, so the tick loop vectorises in any layout.
+    static constexpr std::size_t kChunk = 16;
+
+    // Snapshot of the grid's values at step t (now) and t+1 (next).
+    EagerValues(const Grid& grid, TimeStep t);
+
+    [[nodiscard]] CellValue now(std::size_t k)  const noexcept { return m_now[k]; }
+    [[nodiscard]] CellValue next(std::size_t k) const noexcept { return m_next[k]; }
+    // Value at the next step of a cell collected at this step
+    [[nodiscard]] CellValue nextAfterVisit(std::size_t k) const noexcept {
+        return std::min(m_base[k], m_inc[k]);
+    }
+
+    // Cell k was collected at this step.
+    void visit(std::size_t k) noexcept {
+        m_now[k]  = 0;
+        m_next[k] = nextAfterVisit(k);
+        if (m_next[k] > 0) activate(k / kChunk);
+    }
+
+    // Advances every value by one step.
+    void tick() noexcept;
+
+    [[nodiscard]] std::size_t activeChunks() const noexcept { return m_active.size(); }
+
+private:
+    void activate(std::size_t chunk) {
+        if (!m_isActive[chunk]) {
+            m_isActive[chunk] = 1;
+            m_active.push_back(static_cast<std::uint32_t>(chunk));
+        }
+    }
+
+    const CellValue*           m_base;
+    const CellValue*           m_inc;
+    std::size_t                m_size;
+    GridArray<CellValue>       m_now;
+    GridArray<CellValue>       m_next;
+    std::vector<std::uint32_t> m_active;    // chunks with a cell where now != next
+    std::vector<std::uint8_t>  m_isActive;
+};
@@ -2,11 +2,22 @@
 #include "struct/Grid.h"
 #include "struct/Drone.h"
 #include "struct/GridAlgoConfig.h"
+#include "struct/LoadProgress.h"
 #include "struct/Result.h"
+#include "interfaces/IRunObserver.h"
+#include "EagerValues.h"
+#include "ReservationTable.h"
+#include "StepDeadline.h"
+#include <algorithm>
+#include <bit>
 #include <chrono>
+#include <cmath>
 #include <limits>
+#include <optional>
 #include <stdexcept>
 #include <array>
+#include <utility>
+#include <vector>
 
 std::span<const GridAlgo::Move> GridAlgo::buildMoves(bool allowStay) noexcept {
     static constexpr std::array<Move,8> k8 {{
@@ -22,13 +33,6 @@ std::span<const GridAlgo::Move> GridAlgo::buildMoves(bool allowStay) noexcept {
     }};
     return allowStay ? std::span<const Move>(k8s) : std::span<const Move>(k8);
 }
-int GridAlgo::collectAndUpdate(Grid& grid, Drone& drone, int x, int y, int t) noexcept {
-    const int gain = grid.valueAt(x, y, t);
-    drone.moveTo(x, y, t, gain);
-    grid.markVisited(x, y, t);
-    return gain;
-}
-
 std::pair<int,int> GridAlgo::findBestMove(
     const Grid& grid,
     const Drone& drone,
@@ -49,7 +53,7 @@ std::pair<int,int> GridAlgo::findBestMove(
         long long combined = gain1;
 
         if (horizon >= 2) {
-            const std::size_t idx1 = Grid::idx(nx1, ny1, grid.N);
+            const std::size_t idx1 = grid.idx(nx1, ny1);
             for (auto [dx2, dy2] : moves) {
                 const auto p2 = drone.pos();
                 const int nx2 = nx1 + dx2;
@@ -69,47 +73,499 @@ std::pair<int,int> GridAlgo::findBestMove(
     return {bestDx, bestDy};
 }
 
-RunResult GridAlgo::run(Grid& grid, std::span<Drone> drones, const GridAlgoConfig& cfg) {
-    if (drones.empty()) throw std::runtime_error("No drones to run algorithm");
+namespace {
 
-    const int horizon = (cfg.horizon < 1) ? 1 : (cfg.horizon > 2 ? 2 : cfg.horizon);
-    const auto moves = buildMoves(cfg.allowStay);
+template <bool AllowStay>
+constexpr auto kMoveTable = [] {
+    struct M { int dx; int dy; };
+    if constexpr (AllowStay) {
+        return std::array<M,9>{{
+            {-1,-1},{0,-1},{1,-1},
+            {-1, 0},        {1, 0},
+            {-1, 1},{0, 1},{1, 1},
+            {0,0}
+        }};
+    } else {
+        return std::array<M,8>{{
+            {-1,-1},{0,-1},{1,-1},
+            {-1, 0},        {1, 0},
+            {-1, 1},{0, 1},{1, 1}
+        }};
+    }
+}();
+
+// Calls f.template operator()<I>() for I in [0, N), fully unrolled.
+template <std::size_t N, class F>
+inline void unrolled(F&& f) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (f.template operator()<I>(), ...);
+    }(std::make_index_sequence<N>{});
+}
+
+// Cell values straight from the grid's last-visit times
+class LazyState {
+public:
+    explicit LazyState(Grid& grid) noexcept : m_grid(grid) {}
+
+    CellValue now(std::size_t k, int t) const noexcept  { return m_grid.valueAtIndex(k, t); }
+    CellValue next(std::size_t k, int t) const noexcept { return m_grid.valueAtIndex(k, t + 1); }
+    // Value at t+1 of a cell collected at t
+    CellValue nextAfterVisit(std::size_t k, int t) const noexcept {
+        return m_grid.valueAtIndexWithOverride(k, t + 1, k, t);
+    }
+
+    CellValue collect(std::size_t k, int t) noexcept {
+        const CellValue gain = now(k, t);
+        m_grid.lastVisitTime[k] = t;
+        return gain;
+    }
+    void endStep() noexcept {}
+
+    // Coordination hooks, see ReservedState
+    void beginDrone(int) noexcept {}
+    void intendFrom(Position, int, bool) noexcept {}
+
+private:
+    Grid& m_grid;
+};
+
+// Cell values from EagerValues; the grid's last-visit times are still kept
+// so the grid is left in the same state as a lazy run.
+class EagerState {
+public:
+    EagerState(Grid& grid, int t) : m_grid(grid), m_values(grid, t) {}
+
+    CellValue now(std::size_t k, int) const noexcept            { return m_values.now(k); }
+    CellValue next(std::size_t k, int) const noexcept           { return m_values.next(k); }
+    CellValue nextAfterVisit(std::size_t k, int) const noexcept { return m_values.nextAfterVisit(k); }
+
+    CellValue collect(std::size_t k, int t) noexcept {
+        const CellValue gain = m_values.now(k);
+        m_grid.lastVisitTime[k] = t;
+        m_values.visit(k);
+        return gain;
+    }
+    void endStep() noexcept { m_values.tick(); }
+
+    void beginDrone(int) noexcept {}
+    void intendFrom(Position, int, bool) noexcept {}
+
+private:
+    Grid&       m_grid;
+    EagerValues m_values;
+};
+
+// Another state as seen by a swarm sharing a ReservationTable: next-step
+// values of cells that another drone has claimed for that step are
+// discounted, so a horizon-2 planner stops chasing the same hotspot. Only
+// the planner's view changes; collect() yields the true value.
+//
+// After each move a drone claims the neighbour it would head for next,
+// i.e. the second step of its own lookahead.
+template <class Inner>
+class ReservedState : public Inner {
+public:
+    template <class... Args>
+    ReservedState(ReservationTable& table, double discount, Grid& grid, Args&&... args)
+        : Inner(grid, std::forward<Args>(args)...), m_grid(grid), m_table(table)
+        , m_keepQ16(std::llround((1.0 - discount) * 65536.0)) {}
+
+    CellValue next(std::size_t k, int t) const noexcept { return discounted(k, t + 1, Inner::next(k, t)); }
+    CellValue nextAfterVisit(std::size_t k, int t) const noexcept {
+        return discounted(k, t + 1, Inner::nextAfterVisit(k, t));
+    }
+
+    void beginDrone(int id) noexcept { m_self = id; }
+    // Drone m_self collected p at tNow; claim its best neighbour for tNow+1.
+    void intendFrom(Position p, int tNow, bool allowStay) noexcept {
+        long long best = -1;
+        std::size_t target = Grid::kNoCell;
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                if ((dx == 0 && dy == 0 && !allowStay) || !m_grid.inBounds(p.x + dx, p.y + dy)) continue;
+                const std::size_t k = m_grid.idx(p.x + dx, p.y + dy);
+                const CellValue v = next(k, tNow);
+                if (v > best) { best = v; target = k; }
+            }
+        }
+        if (target != Grid::kNoCell && best > 0) m_table.claim(target, tNow + 1, m_self);
+    }
+
+private:
+    CellValue discounted(std::size_t k, int t, CellValue v) const noexcept {
+        const CellValue cut = static_cast<CellValue>((static_cast<long long>(v) * m_keepQ16) >> 16);
+        return m_table.claimedByOther(k, t, m_self) ? cut : v;
+    }
+
+    const Grid&       m_grid;
+    ReservationTable& m_table;
+    long long         m_keepQ16;   // 1 - discount, 16.16 fixed point
+    int               m_self = 0;
+};
+
+} // namespace
+
+// Auto rule for eager values, measured on data/{100,1000}.txt (horizon 2,
+// regrowth 0.1, one core). With fewer than ~16 drones lazy probes mostly hit
+// L1 and the per-step tick costs more than it saves; from 16 drones up eager
+// ran 1.2-3x faster. Building the eager arrays costs ~8 ns per map cell,
+// which takes about 0.1 drone-steps per cell to earn back.
+constexpr int    kEagerMinDrones         = 16;
+constexpr double kEagerDroneStepsPerCell = 0.1;
+
+bool GridAlgo::preferEager(int gridN, int drones, int steps) noexcept {
+    const double cells      = static_cast<double>(gridN) * static_cast<double>(gridN);
+    const double droneSteps = static_cast<double>(drones) * static_cast<double>(steps);
+    return drones >= kEagerMinDrones && droneSteps >= kEagerDroneStepsPerCell * cells;
+}
+
+// Same search order and tie-breaking as findBestMove, so both kernels pick
+// identical moves. Only the inner (second-step) loop is unrolled: unrolling
+// both levels produces 81 inlined probes and measured slower than this.
+//
+// On a padded grid every probe within the lookahead window lands in storage,
+// and sentinel cells score far below any real cell, so the bounds checks go
+// away and cells are addressed by offset from the drone's index.
+template <int Horizon, bool AllowStay, bool Padded, class State>
+std::pair<int,int> GridAlgo::findBestMoveFixed(const Grid& grid, const State& values,
+                                               Position p, int tNow) noexcept {
+    constexpr auto& moves = kMoveTable<AllowStay>;
+    long long bestGain = std::numeric_limits<long long>::min();
+    int bestDx = 0, bestDy = 0;
+    const std::size_t k0 = grid.idx(p.x, p.y);
+
+    for (const auto m1 : moves) {
+        const int nx1 = p.x + m1.dx;
+        const int ny1 = p.y + m1.dy;
+        if constexpr (!Padded) {
+            if (!grid.inBounds(nx1, ny1)) continue;
+        }
+        const std::size_t idx1 = Padded ? k0 + grid.offset(m1.dx, m1.dy) : grid.idx(nx1, ny1);
+
+        const int gain1 = values.now(idx1, tNow);
+        long long combined = gain1;
+
+        if constexpr (Horizon >= 2) {
+            unrolled<moves.size()>([&]<std::size_t J>() {
+                constexpr auto m2 = moves[J];
+                if constexpr (!Padded) {
+                    if (!grid.inBounds(nx1 + m2.dx, ny1 + m2.dy)) return;
+                }
+                int gain2;
+                if constexpr (m2.dx == 0 && m2.dy == 0) {
+                    gain2 = values.nextAfterVisit(idx1, tNow);
+                } else {
+                    gain2 = values.next(idx1 + grid.offset(m2.dx, m2.dy), tNow);
+                }
+                const long long twoStep = static_cast<long long>(gain1) + gain2;
+                if (twoStep > combined) combined = twoStep;
+            });
+        }
+
+        if (combined > bestGain) {
+            bestGain = combined;
+            bestDx = m1.dx; bestDy = m1.dy;
+        }
+    }
+    return {bestDx, bestDy};
+}
+
+// Kernel for the tiled layout, where a (dx,dy) step is not a constant index
+// delta. The lookahead block is resolved once via Grid::neighbourhood and the
+// second-step values are computed once per cell instead of once per path.
+// Search order and tie-breaking match findBestMove.
+template <int Horizon, bool AllowStay, bool Padded, class State>
+std::pair<int,int> GridAlgo::findBestMoveWindow(const Grid& grid, const State& values,
+                                                Position p, int tNow) noexcept {
+    constexpr auto& moves = kMoveTable<AllowStay>;
+    constexpr int R    = Horizon >= 2 ? 2 : 1;
+    constexpr int side = 2 * R + 1;
+    constexpr int mid  = R * side + R;
+
+    std::array<std::size_t, side * side> cell;
+    grid.neighbourhood<R>(p.x, p.y, cell);
+
+    std::array<CellValue, side * side> next{};
+    if constexpr (Horizon >= 2) {
+        for (std::size_t c = 0; c < cell.size(); ++c) {
+            if (Padded || cell[c] != Grid::kNoCell) next[c] = values.next(cell[c], tNow);
+        }
+    }
+
+    long long bestGain = std::numeric_limits<long long>::min();
+    int bestDx = 0, bestDy = 0;
+
+    for (const auto m1 : moves) {
+        const int c1 = mid + m1.dy * side + m1.dx;
+        const std::size_t idx1 = cell[static_cast<std::size_t>(c1)];
+        if constexpr (!Padded) {
+            if (idx1 == Grid::kNoCell) continue;
+        }
+
+        const int gain1 = values.now(idx1, tNow);
+        long long combined = gain1;
+
+        if constexpr (Horizon >= 2) {
+            unrolled<moves.size()>([&]<std::size_t J>() {
+                constexpr auto m2 = moves[J];
+                const std::size_t c2 = static_cast<std::size_t>(c1 + m2.dy * side + m2.dx);
+                if constexpr (!Padded) {
+                    if (cell[c2] == Grid::kNoCell) return;
+                }
+                int gain2;
+                if constexpr (m2.dx == 0 && m2.dy == 0) {
+                    gain2 = values.nextAfterVisit(idx1, tNow);
+                } else {
+                    gain2 = next[c2];
+                }
+                const long long twoStep = static_cast<long long>(gain1) + gain2;
+                if (twoStep > combined) combined = twoStep;
+            });
+        }
+
+        if (combined > bestGain) {
+            bestGain = combined;
+            bestDx = m1.dx; bestDy = m1.dy;
+        }
+    }
+    return {bestDx, bestDy};
+}
+
+template <class State, class BestMoveFn, class ShallowMoveFn>
+RunResult GridAlgo::runLoop(Grid& grid, std::span<Drone> drones, const GridAlgoConfig& cfg,
+                            std::chrono::steady_clock::time_point tStart, State& state,
+                            int horizon, BestMoveFn&& bestMove, ShallowMoveFn&& shallowMove) {
+    using Clock = std::chrono::steady_clock;
+    using Level = StepDeadline::Level;
 
-    const auto tStart = std::chrono::steady_clock::now();
     RunResult result;
     result.drones = static_cast<int>(drones.size());
-    result.paths.reserve(drones.size());
+    result.totalScore = cfg.initialScore;
+    if (!cfg.summaryOnly) result.paths.reserve(drones.size());
 
-    // t = 0 initialization
-    for (auto& d : drones) {
-        const auto p = d.pos();
-        result.totalScore += collectAndUpdate(grid, d, p.x, p.y, /*t=*/0);
+    // Pipelined load: a drone's lookahead reaches kPad rows below it, so wait
+    // for those before planning it. Dropped once the last row is in.
+    const LoadProgress* loading = grid.loading;
+    auto waitForRows = [&](Position p) {
+        if (loading) loading->waitForRow(std::min(grid.N - 1, p.y + Grid::kPad));
+    };
+    // Summary mode: instead of a path, count first visits and bin the
+    // collected values by bit width (see RunSummary)
+    const bool summaryOnly = cfg.summaryOnly;
+    long long stepsDone = std::max(1, cfg.firstStep);
+    long long distinct  = 0;
+    std::array<long long, std::numeric_limits<unsigned>::digits + 1> valueBins{};
+    auto collect = [&](Drone& d, int x, int y, int t) {
+        const std::size_t k = grid.idx(x, y);
+        if (summaryOnly) {
+            distinct += grid.lastVisitTime[k] < 0;
+            const int gain = state.collect(k, t);
+            ++valueBins[static_cast<std::size_t>(std::bit_width(static_cast<unsigned>(std::max(gain, 0))))];
+            d.moveUnrecorded(x, y);
+            return gain;
+        }
+        const int gain = state.collect(k, t);
+        d.moveTo(x, y, t, gain);
+        return gain;
+    };
+
+    // t = 0 initialization (already done when resuming)
+    if (cfg.firstStep <= 0) {
+        for (auto& d : drones) {
+            const auto p = d.pos();
+            waitForRows(p);
+            result.totalScore += collect(d, p.x, p.y, /*t=*/0);
+        }
+        state.endStep();
     }
 
+    const bool observe = cfg.observer && cfg.observeEvery > 0;
+
+    // Applies a planned move; returns the one actually taken
+    auto apply = [&](Drone& d, Position p, std::pair<int,int> move, int tNow) {
+        int nx = p.x + move.first;
+        int ny = p.y + move.second;
+        if (!grid.inBounds(nx, ny)) { nx = p.x; ny = p.y; }
+        result.totalScore += collect(d, nx, ny, tNow);
+        return std::pair<int,int>{ nx - p.x, ny - p.y };
+    };
+
+    // Step deadline: each drone is planned at the level StepDeadline gives
+    // it. A cached move that cannot be repeated (none yet, off the map, or a
+    // stay with staying disabled) falls back to horizon 1.
+    constexpr int kNoMove = 2;
+    std::optional<StepDeadline> deadline;
+    std::vector<std::pair<int,int>> lastMove;
+    if (cfg.stepDeadlineUs > 0) {
+        deadline.emplace(std::chrono::microseconds(cfg.stepDeadlineUs), drones.size(), horizon <= 1);
+        lastMove.assign(drones.size(), { kNoMove, 0 });
+    }
+    auto repeatable = [&](Position p, std::pair<int,int> move) {
+        const auto [dx, dy] = move;
+        return dx != kNoMove && grid.inBounds(p.x + dx, p.y + dy) && (cfg.allowStay || dx != 0 || dy != 0);
+    };
+
     // main loop
-    for (int tNow = 1; tNow < cfg.totalSteps; ++tNow) {
-        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::steady_clock::now() - tStart).count();
+    for (int tNow = std::max(1, cfg.firstStep); tNow < cfg.totalSteps; ++tNow) {
+        const auto stepStart = Clock::now();
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(stepStart - tStart).count();
         if (elapsed >= cfg.timeBudgetMs) break;
+        if (loading && loading->complete()) loading = nullptr;
 
-        for (auto& d : drones) {
-            const auto p = d.pos();
-            auto [dx, dy] = findBestMove(grid, d, moves, tNow, horizon);
-            int nx = p.x + dx;
-            int ny = p.y + dy;
-            if (!grid.inBounds(nx, ny)) { nx = p.x; ny = p.y; }
-            result.totalScore += collectAndUpdate(grid, d, nx, ny, tNow);
+        if (deadline) {
+            deadline->beginStep();
+            auto t0 = stepStart;
+            for (std::size_t i = 0; i < drones.size(); ++i) {
+                Drone& d = drones[i];
+                const auto p = d.pos();
+                waitForRows(p);
+                Level level = deadline->levelFor(i, t0 - stepStart);
+                if (level == Level::Cached && !repeatable(p, lastMove[i])) {
+                    level = horizon > 1 ? Level::Shallow : Level::Full;
+                }
+                std::pair<int,int> move = lastMove[i];
+                state.beginDrone(d.id());
+                if (level == Level::Full)    move = bestMove(d, tNow);
+                if (level == Level::Shallow) move = shallowMove(d, tNow);
+                lastMove[i] = apply(d, p, move, tNow);
+                state.intendFrom(d.pos(), tNow, cfg.allowStay);
+
+                const auto t1 = Clock::now();
+                deadline->record(level, t1 - t0);
+                t0 = t1;
+            }
+        } else {
+            for (auto& d : drones) {
+                const auto p = d.pos();
+                waitForRows(p);
+                state.beginDrone(d.id());
+                apply(d, p, bestMove(d, tNow), tNow);
+                state.intendFrom(d.pos(), tNow, cfg.allowStay);
+            }
+        }
+        state.endStep();
+        ++stepsDone;
+
+        if (observe && tNow % cfg.observeEvery == 0) {
+            cfg.observer->onStep(tNow, result.totalScore, drones);
         }
+        if (deadline) deadline->endStep(Clock::now() - stepStart);
     }
+    if (deadline) result.stepLatency = deadline->report();
 
     result.timeElapsedMs = static_cast<int>(
         std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::steady_clock::now() - tStart).count()
     );
 
+    if (summaryOnly) {
+        RunSummary& summary = result.summary.emplace();
+        summary.steps         = stepsDone;
+        summary.distinctCells = distinct;
+        std::size_t bins = valueBins.size();
+        while (bins > 0 && valueBins[bins - 1] == 0) --bins;
+        summary.valueHistogram.assign(valueBins.begin(), valueBins.begin() + static_cast<std::ptrdiff_t>(bins));
+        return result;
+    }
+
     // extract paths
     for (auto& d : drones) {
         result.paths.push_back(DronePath{ d.id(), d.path() });
     }
     return result;
 }
+
+template <int Horizon, bool AllowStay, bool Padded, class State>
+RunResult GridAlgo::runFixed(Grid& grid, std::span<Drone> drones, const GridAlgoConfig& cfg,
+                             std::chrono::steady_clock::time_point tStart, State& state) {
+    if (grid.tiled()) return runWindowed<Horizon, AllowStay, Padded>(grid, drones, cfg, tStart, state);
+    return runLoop(grid, drones, cfg, tStart, state, Horizon,
+        [&grid, &state](const Drone& d, int tNow) {
+            return findBestMoveFixed<Horizon, AllowStay, Padded>(grid, state, d.pos(), tNow);
+        },
+        [&grid, &state](const Drone& d, int tNow) {
+            return findBestMoveFixed<1, AllowStay, Padded>(grid, state, d.pos(), tNow);
+        });
+}
+
+template <int Horizon, bool AllowStay, bool Padded, class State>
+RunResult GridAlgo::runWindowed(Grid& grid, std::span<Drone> drones, const GridAlgoConfig& cfg,
+                                std::chrono::steady_clock::time_point tStart, State& state) {
+    return runLoop(grid, drones, cfg, tStart, state, Horizon,
+        [&grid, &state](const Drone& d, int tNow) {
+            return findBestMoveWindow<Horizon, AllowStay, Padded>(grid, state, d.pos(), tNow);
+        },
+        [&grid, &state](const Drone& d, int tNow) {
+            return findBestMoveWindow<1, AllowStay, Padded>(grid, state, d.pos(), tNow);
+        });
+}
+
+template <int Horizon, bool AllowStay, class State>
+RunResult GridAlgo::runFixed(Grid& grid, std::span<Drone> drones, const GridAlgoConfig& cfg,
+                             std::chrono::steady_clock::time_point tStart, State& state) {
+    return grid.padded() ? runFixed<Horizon, AllowStay, true>(grid, drones, cfg, tStart, state)
+                         : runFixed<Horizon, AllowStay, false>(grid, drones, cfg, tStart, state);
+}
+
+template <class State>
+RunResult GridAlgo::runSpecialized(Grid& grid, std::span<Drone> drones, const GridAlgoConfig& cfg,
+                                   std::chrono::steady_clock::time_point tStart,
+                                   int horizon, State& state) {
+    if (horizon >= 2) {
+        return cfg.allowStay ? runFixed<2, true>(grid, drones, cfg, tStart, state)
+                             : runFixed<2, false>(grid, drones, cfg, tStart, state);
+    }
+    return cfg.allowStay ? runFixed<1, true>(grid, drones, cfg, tStart, state)
+                         : runFixed<1, false>(grid, drones, cfg, tStart, state);
+}
+
+RunResult GridAlgo::run(Grid& grid, std::span<Drone> drones, const GridAlgoConfig& cfg) {
+    const auto tStart = std::chrono::steady_clock::now();
+    if (drones.empty()) throw std::runtime_error("No drones to run algorithm");
+
+    const int horizon = (cfg.horizon < 1) ? 1 : (cfg.horizon > 2 ? 2 : cfg.horizon);
+
+    if (m_kernel == Kernel::Generic) {
+        const auto moves = buildMoves(cfg.allowStay);
+        LazyState state(grid);
+        return runLoop(grid, drones, cfg, tStart, state, horizon,
+            [&](const Drone& d, int tNow) { return findBestMove(grid, d, moves, tNow, horizon); },
+            [&](const Drone& d, int tNow) { return findBestMove(grid, d, moves, tNow, 1); });
+    }
+
+    // Auto stays lazy while a pipelined load is running: the eager arrays
+    // would need the whole map before the first move. It also stays lazy
+    // under a step deadline, where the bulk tick is a per-step cost that
+    // cannot be cut back.
+    const int firstStep = std::max(0, cfg.firstStep);
+    const bool eager = m_values == Values::Eager ||
+        (m_values == Values::Auto && !grid.loading && cfg.stepDeadlineUs <= 0 &&
+         preferEager(grid.N, static_cast<int>(drones.size()), cfg.totalSteps - firstStep));
+    const bool coordinate = m_reservationDiscount > 0.0 && horizon >= 2 && drones.size() > 1;
+    if (eager) {
+        if (grid.loading) grid.loading->waitForRow(grid.N - 1);
+        if (coordinate) return runCoordinated<EagerState>(grid, drones, cfg, tStart, firstStep);
+        EagerState state(grid, firstStep);
+        return runSpecialized(grid, drones, cfg, tStart, horizon, state);
+    }
+    if (coordinate) return runCoordinated<LazyState>(grid, drones, cfg, tStart);
+    LazyState state(grid);
+    return runSpecialized(grid, drones, cfg, tStart, horizon, state);
+}
+
+template <class State, class... StateArgs>
+RunResult GridAlgo::runCoordinated(Grid& grid, std::span<Drone> drones, const GridAlgoConfig& cfg,
+                                   std::chrono::steady_clock::time_point tStart,
+                                   StateArgs&&... stateArgs) const {
+    ReservationTable table(grid.base.size());
+    ReservedState<State> state(table, std::clamp(m_reservationDiscount, 0.0, 1.0), grid,
+                               std::forward<StateArgs>(stateArgs)...);
+    // Always the window kernel: it reads each cell's discounted next value
+    // once, where the fixed kernel re-reads overlapping cells up to 8 times.
+    if (grid.padded()) {
+        return cfg.allowStay ? runWindowed<2, true, true>(grid, drones, cfg, tStart, state)
+                             : runWindowed<2, false, true>(grid, drones, cfg, tStart, state);
+    }
+    return cfg.allowStay ? runWindowed<2, true, false>(grid, drones, cfg, tStart, state)
+                         : runWindowed<2, false, false>(grid, drones, cfg, tStart, state);
+}
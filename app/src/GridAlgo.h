@@ -1,4 +1,5 @@
 #pragma once
+#include <chrono>
 #include <span>
 #include <vector>
 #include <utility>
@@ -10,8 +11,35 @@
 class Grid;
 class Drone;
 
+struct Position;
+
 class GridAlgo final : public IGridAlgo {
 public:
+    // Specialized: one kernel per <horizon, allowStay> over constexpr move
+    //              tables, selected once per run.
+    // Generic:     runtime horizon and move span (reference implementation).
+    enum class Kernel { Specialized, Generic };
+
+    // How the specialized kernels read cell values.
+    // Lazy:  derive each probe from the last-visit time (Grid::valueAtIndex).
+    // Eager: keep current values in EagerValues, advanced by a bulk tick once
+    //        per step; a probe is one load. Pays off when drones are dense.
+    // Auto:  eager when preferEager() says so. The generic kernel is always lazy.
+    enum class Values { Lazy, Eager, Auto };
+
+    // reservationDiscount in [0, 1]: with horizon 2 and several drones, each
+    // drone claims the cell it heads for next in a shared ReservationTable,
+    // and the others see that cell's next-step value cut by this fraction.
+    // 0 (default) plans every drone on its own. Specialized kernel only.
+    explicit GridAlgo(Kernel kernel = Kernel::Specialized, Values values = Values::Auto,
+                      double reservationDiscount = 0.0) noexcept
+        : m_kernel(kernel), m_values(values), m_reservationDiscount(reservationDiscount) {}
+
+    // Auto rule: eager for swarms (enough drones per step that lazy probes
+    // miss cache) whose run is long enough, in drone-steps per map cell, to
+    // pay for building the eager arrays.
+    [[nodiscard]] static bool preferEager(int gridN, int drones, int steps) noexcept;
+
     [[nodiscard]] RunResult run(Grid& grid, std::span<Drone> drones, const GridAlgoConfig& cfg) override;
 
 private:
@@ -27,5 +55,42 @@ private:
         int horizon
     ) const noexcept;
 
-    static int collectAndUpdate(Grid& grid, Drone& drone, int x, int y, int t) noexcept;
+    template <int Horizon, bool AllowStay, bool Padded, class State>
+    static std::pair<int,int> findBestMoveFixed(const Grid& grid, const State& values,
+                                                Position p, int tNow) noexcept;
+
+    template <int Horizon, bool AllowStay, bool Padded, class State>
+    static std::pair<int,int> findBestMoveWindow(const Grid& grid, const State& values,
+                                                 Position p, int tNow) noexcept;
+
+    // tStart: when run() was entered, so state setup counts against the budget.
+    // shallowMove plans at horizon 1; used under a step deadline.
+    template <class State, class BestMoveFn, class ShallowMoveFn>
+    static RunResult runLoop(Grid& grid, std::span<Drone> drones, const GridAlgoConfig& cfg,
+                             std::chrono::steady_clock::time_point tStart, State& state,
+                             int horizon, BestMoveFn&& bestMove, ShallowMoveFn&& shallowMove);
+
+    template <int Horizon, bool AllowStay, bool Padded, class State>
+    static RunResult runFixed(Grid& grid, std::span<Drone> drones, const GridAlgoConfig& cfg,
+                              std::chrono::steady_clock::time_point tStart, State& state);
+    // Window kernels whatever the layout
+    template <int Horizon, bool AllowStay, bool Padded, class State>
+    static RunResult runWindowed(Grid& grid, std::span<Drone> drones, const GridAlgoConfig& cfg,
+                                 std::chrono::steady_clock::time_point tStart, State& state);
+    template <int Horizon, bool AllowStay, class State>
+    static RunResult runFixed(Grid& grid, std::span<Drone> drones, const GridAlgoConfig& cfg,
+                              std::chrono::steady_clock::time_point tStart, State& state);
+    template <class State>
+    static RunResult runSpecialized(Grid& grid, std::span<Drone> drones, const GridAlgoConfig& cfg,
+                                    std::chrono::steady_clock::time_point tStart,
+                                    int horizon, State& state);
+
+    // Horizon 2 over a ReservedState<State> built from (grid, stateArgs...)
+    template <class State, class... StateArgs>
+    RunResult runCoordinated(Grid& grid, std::span<Drone> drones, const GridAlgoConfig& cfg,
+                             std::chrono::steady_clock::time_point tStart, StateArgs&&... stateArgs) const;
+
+    Kernel m_kernel;
+    Values m_values;
+    double m_reservationDiscount;
 };
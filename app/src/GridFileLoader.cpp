@@ -6,8 +6,8 @@
 #include <vector>
 #include <cctype>
 #include <cmath>
+#include <charconv>
 #include "struct/Grid.h"
-#include "io/json.h"
 struct GridLoadError : std::runtime_error { using std::runtime_error::runtime_error; };
 
 static inline std::string trim(const std::string& s) {
@@ -17,9 +17,22 @@ static inline std::string trim(const std::string& s) {
     return s.substr(l, r - l);
 }
 
-GridFileLoader::GridFileLoader(std::filesystem::path filePath, double regrowthRate)
+int GridFileLoader::regrowthIncrement(int base, double regrowthRate) noexcept {
+    if (regrowthRate == 0.0) {
+        return 0;
+    }
+    int inc = static_cast<int>(std::llround(static_cast<double>(base) * regrowthRate));
+    if (base > 0 && inc <= 0) {
+        inc = 1; // ensure minimal positive increment when regrowth enabled
+    }
+    return inc;
+}
+
+GridFileLoader::GridFileLoader(std::filesystem::path filePath, double regrowthRate,
+                               GridStorageConfig storage)
     : m_filePath(std::move(filePath))
     , m_regrowthRate(regrowthRate)
+    , m_storage(storage)
 {
     if (m_regrowthRate < 0.0) {
         throw GridLoadError("regrowthRate must be >= 0");
@@ -27,55 +40,54 @@ GridFileLoader::GridFileLoader(std::filesystem::path filePath, double regrowthRa
 }
 
 std::unique_ptr<Grid> GridFileLoader::loadGrid() const {
+    LoadProgress progress;
+    loadGridStreaming(progress);
+    return progress.takeGrid();
+}
+
+void GridFileLoader::loadGridStreaming(LoadProgress& progress) const {
     std::ifstream in(m_filePath);
     if (!in) {
         throw GridLoadError("Failed to open file: " + m_filePath.string());
     }
-    std::ostringstream oss;
-    oss << in.rdbuf();
 
     try {
-        Grid g = parseText(oss.str(), m_regrowthRate);
-        return std::make_unique<Grid>(std::move(g));
+        parseStream(in, m_regrowthRate, m_storage, progress);
     } catch (const std::exception& e) {
         throw GridLoadError("While parsing '" + m_filePath.string() + "': " + std::string(e.what()));
     }
 }
 
-Grid GridFileLoader::parseText(const std::string& text, double regrowthRate) {
-    std::vector<std::string> lines;
-    lines.reserve(128);
-
-    std::istringstream iss(text);
-    std::string line;
-    while (std::getline(iss, line)) {
-        // Strip comments starting with '#' (optional)
+// Next non-blank line with '#' comments stripped and whitespace trimmed;
+// false at end of input.
+static bool nextContentLine(std::istream& in, std::string& line) {
+    while (std::getline(in, line)) {
         if (auto pos = line.find('#'); pos != std::string::npos) {
             line.erase(pos);
         }
         line = trim(line);
-        if (!line.empty()) lines.emplace_back(std::move(line));
+        if (!line.empty()) return true;
     }
+    return false;
+}
 
-    if (lines.empty()) {
+void GridFileLoader::parseStream(std::istream& in, double regrowthRate,
+                                 const GridStorageConfig& storage, LoadProgress& progress) {
+    std::string line;
+    if (!nextContentLine(in, line)) {
         throw GridLoadError("Empty grid file");
     }
 
-    auto tokenize = [](const std::string& s, int lineNo) -> std::vector<int> {
-        std::vector<int> out;
-        std::istringstream ls(s);
+    // Header: N
+    std::vector<int> header;
+    {
+        std::istringstream ls(line);
         int v;
-        while (ls >> v) {
-            out.push_back(v);
-        }
+        while (ls >> v) header.push_back(v);
         if (!ls.eof()) {
-            throw GridLoadError("Non-integer token at line " + std::to_string(lineNo));
+            throw GridLoadError("Non-integer token at line 1");
         }
-        return out;
-    };
-
-    // Header: N
-    const auto header = tokenize(lines[0], /*lineNo=*/1);
+    }
     if (header.size() != 1) {
         throw GridLoadError("First line must contain a single integer N");
     }
@@ -91,49 +103,47 @@ Grid GridFileLoader::parseText(const std::string& text, double regrowthRate) {
         throw GridLoadError("N too large: " + std::to_string(N));
     }
 
-    if (static_cast<int>(lines.size()) - 1 < N) {
-        throw GridLoadError("Not enough grid rows after header N=" + std::to_string(N) +
-                            "; provided=" + std::to_string(lines.size() - 1));
-    }
-
-    std::vector<std::vector<int>> rows;
-    rows.reserve(N);
-    for (int i = 0; i < N; ++i) {
-        rows.push_back(tokenize(lines[1 + i], /*lineNo=*/2 + i));
-        if (static_cast<int>(rows.back().size()) != N) {
-            throw GridLoadError("Row " + std::to_string(2 + i) +
-                                " must have exactly N integers (found " +
-                                std::to_string(rows.back().size()) + ")");
-        }
-    }
+    // Rows are written straight into the grid's storage layout, and each
+    // finished row is published so a pipelined planner can start early.
+    auto owned = std::make_unique<Grid>();
+    Grid& g = *owned;
+    g.initialize(N, storage);
+    progress.publishGrid(std::move(owned));
 
-    Grid g;
-    g.N = N;
-    const std::size_t total = static_cast<std::size_t>(N) * static_cast<std::size_t>(N);
-
-    g.base.resize(total);
-    g.lastVisitTime.assign(total, -1);
     for (int y = 0; y < N; ++y) {
-        for (int x = 0; x < N; ++x) {
-            const int v = rows[y][x];
-            g.base[static_cast<std::size_t>(g.idx(x, y, N))] = (v < 0 ? 0 : v);
+        if (!nextContentLine(in, line)) {
+            throw GridLoadError("Not enough grid rows after header N=" + std::to_string(N) +
+                                "; provided=" + std::to_string(y));
         }
-    }
-
-    g.inc.resize(total);
-    for (std::size_t i = 0; i < total; ++i) {
-        const int b = g.base[i];
-        long long incLL = std::llround(static_cast<double>(b) * regrowthRate);
-        int inc = static_cast<int>(incLL);
-
-        if (regrowthRate > 0.0 && b > 0 && inc <= 0) {
-            inc = 1; // ensure minimal positive increment when regrowth enabled
+        const char* p   = line.data();
+        const char* end = p + line.size();
+        int found = 0;
+        while (p != end) {
+            if (std::isspace(static_cast<unsigned char>(*p))) { ++p; continue; }
+            if (*p == '+') {
+                // accepted by the stream parser this replaced, but only before a digit
+                ++p;
+                if (p != end && (*p == '+' || *p == '-')) {
+                    throw GridLoadError("Non-integer token at line " + std::to_string(2 + y));
+                }
+            }
+            int v = 0;
+            const auto [next, ec] = std::from_chars(p, end, v);
+            if (ec != std::errc{} || (next != end && !std::isspace(static_cast<unsigned char>(*next)))) {
+                throw GridLoadError("Non-integer token at line " + std::to_string(2 + y));
+            }
+            p = next;
+            if (found < N) {
+                const int b = (v < 0 ? 0 : v);
+                g.setCell(found, y, b, regrowthIncrement(b, regrowthRate));
+            }
+            ++found;
         }
-        if (regrowthRate == 0.0) {
-            inc = 0; 
+        if (found != N) {
+            throw GridLoadError("Row " + std::to_string(2 + y) +
+                                " must have exactly N integers (found " +
+                                std::to_string(found) + ")");
         }
-        g.inc[i] = inc;
+        progress.publishRows(y + 1);
     }
-
-    return g;
 }
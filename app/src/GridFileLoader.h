@@ -1,16 +1,23 @@
 #pragma once
 #include <filesystem>
+#include <istream>
 #include <memory>
 #include "interfaces/IGridLoader.h"
+#include "struct/GridStorageConfig.h"
 
 class GridFileLoader final : public IGridLoader {
 public:
-    GridFileLoader(std::filesystem::path filePath, double regrowthRate);
+    GridFileLoader(std::filesystem::path filePath, double regrowthRate,
+                   GridStorageConfig storage = {});
     [[nodiscard]] std::unique_ptr<Grid> loadGrid() const override;
+    void loadGridStreaming(LoadProgress& progress) const override;
 
 private:
-    static Grid parseText(const std::string& text, double regrowthRate);
+    static int  regrowthIncrement(int base, double regrowthRate) noexcept;
+    static void parseStream(std::istream& in, double regrowthRate,
+                            const GridStorageConfig& storage, LoadProgress& progress);
 
     const std::filesystem::path m_filePath;
     const double                m_regrowthRate;
+    const GridStorageConfig     m_storage;
 };
@@ -1,9 +1,15 @@
 #include "GridHandler.h"
+#include <algorithm>
 #include <stdexcept>
 #include <utility>
 #include "struct/GridAlgoConfig.h"
 #include "io/json.h"
+#include "JsonPathWriter.h"
+#include "ObserverSet.h"
+#include "ScoreValidator.h"
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 struct GridError : std::runtime_error { using std::runtime_error::runtime_error; };
 struct AlgoError : std::runtime_error { using std::runtime_error::runtime_error; };
 
@@ -30,15 +36,42 @@ GridHandler::GridHandler(std::unique_ptr<IGridLoader> gridLoader,
     }
 }
 
-GridHandler::~GridHandler() = default;
+GridHandler::~GridHandler()
+{
+    if (m_load && m_load->thread.joinable()) {
+        m_load->thread.join();
+    }
+}
+
+void GridHandler::enablePipelining()
+{
+    m_pipelined = true;
+}
+
+void GridHandler::enableProfiling()
+{
+    m_profiling = true;
+}
+
+void GridHandler::enableValidation()
+{
+    m_validating = true;
+}
 
 void GridHandler::loadGrid()
 {
-    try {
-        m_grid = m_gridLoader->loadGrid();
-    } catch (const std::exception& e) {
-        throw GridError(std::string("Failed to load grid: ") + e.what());
+    m_profile.start = Clock::now();
+    if (m_pipelined) {
+        startPipelinedLoad();
+    } else {
+        try {
+            m_grid = m_gridLoader->loadGrid();
+        } catch (const std::exception& e) {
+            throw GridError(std::string("Failed to load grid: ") + e.what());
+        }
+        m_profile.loadDone = Clock::now();
     }
+    m_profile.gridReady = Clock::now();
 
     if (!m_grid) {
         throw GridError("Loader returned null grid");
@@ -57,11 +90,142 @@ void GridHandler::loadGrid()
     }
 }
 
+void GridHandler::startPipelinedLoad()
+{
+    m_load = std::make_unique<PipelinedLoad>();
+    PipelinedLoad*     load   = m_load.get();
+    const IGridLoader* loader = m_gridLoader.get();
+    load->loaded = load->finished.get_future().share();
+    load->thread = std::thread([load, loader] {
+        try {
+            loader->loadGridStreaming(load->progress);
+        } catch (...) {
+            load->error = std::current_exception();
+            load->progress.fail(load->error);
+        }
+        load->done = Clock::now();
+        if (load->error) load->finished.set_exception(load->error);
+        else             load->finished.set_value();
+    });
+
+    try {
+        load->progress.waitForGrid();
+    } catch (const std::exception&) {
+        finishLoad();   // reports the loader's error
+        throw;
+    }
+    m_grid = load->progress.takeGrid();
+    m_grid->loading = &load->progress;
+}
+
+void GridHandler::finishLoad()
+{
+    if (!m_load) return;
+    if (m_load->thread.joinable()) {
+        m_load->thread.join();
+    }
+    if (m_grid) {
+        m_grid->loading = nullptr;
+    }
+    m_profile.loadDone = m_load->done;
+    const auto error = std::exchange(m_load->error, nullptr);
+    m_load.reset();
+    if (error) {
+        try {
+            std::rethrow_exception(error);
+        } catch (const std::exception& e) {
+            throw GridError(std::string("Failed to load grid: ") + e.what());
+        }
+    }
+}
+
 void GridHandler::initializeDrones()
 {
     for (auto& drone : m_drones) {
-        drone.resetToStart(m_cfg.totalSteps);
+        drone.resetToStart(m_cfg.summaryOnly ? 0 : m_cfg.totalSteps);
+    }
+}
+
+void GridHandler::enableCheckpoints(std::filesystem::path path, int every)
+{
+    m_checkpointPath  = std::move(path);
+    m_checkpointEvery = every;
+}
+
+void GridHandler::setRunIdentity(RunIdentity identity)
+{
+    m_identity = std::move(identity);
+}
+
+Checkpoint GridHandler::initialCheckpoint() const
+{
+    Checkpoint cp;
+    cp.gridN     = m_grid->N;
+    cp.horizon   = m_cfg.horizon;
+    cp.allowStay = m_cfg.allowStay;
+    cp.stepDeadlineUs = m_cfg.stepDeadlineUs;
+    cp.run       = m_identity;   // mapHash is filled in by the writer
+    for (const auto& drone : m_drones) {
+        cp.drones.push_back(DroneCheckpoint{ drone.id(), drone.start(), {} });
+    }
+    return cp;
+}
+
+void GridHandler::resumeFrom(const std::filesystem::path& path)
+{
+    if (!m_grid) {
+        throw GridError("Grid must be loaded before resuming");
+    }
+    Checkpoint cp = loadCheckpoint(path);
+
+    const std::string from = "Checkpoint " + path.string() + " was written ";
+    if (cp.gridN != m_grid->N || cp.horizon != m_cfg.horizon || cp.allowStay != m_cfg.allowStay ||
+        cp.stepDeadlineUs != m_cfg.stepDeadlineUs) {
+        throw GridError(from + "for a different grid size or planner settings");
+    }
+    if (cp.run.regrowthRate != m_identity.regrowthRate) {
+        throw GridError(from + "with regrowth rate " + std::to_string(cp.run.regrowthRate) +
+                        ", run has " + std::to_string(m_identity.regrowthRate));
+    }
+    if (cp.run.planner != m_identity.planner) {
+        throw GridError(from + "by planner '" + cp.run.planner + "', run uses '" + m_identity.planner + "'");
+    }
+    if (cp.run.plannerParams != m_identity.plannerParams) {
+        throw GridError(from + "with different planner parameters");
+    }
+    if (m_load) {
+        m_load->progress.waitForRow(m_grid->N - 1);   // the hash needs the whole map
+    }
+    if (cp.mapHash != mapHash(*m_grid)) {
+        throw GridError(from + "for a different map");
+    }
+    if (cp.drones.size() != m_drones.size()) {
+        throw GridError("Checkpoint has " + std::to_string(cp.drones.size()) +
+                        " drones, run has " + std::to_string(m_drones.size()));
+    }
+    for (std::size_t i = 0; i < m_drones.size(); ++i) {
+        const auto& saved = cp.drones[i];
+        const auto  start = m_drones[i].start();
+        if (saved.droneId != m_drones[i].id() || saved.start.x != start.x || saved.start.y != start.y) {
+            throw GridError("Checkpoint drone " + std::to_string(saved.droneId) + " has a different start position");
+        }
+        for (const auto& s : saved.path) {
+            if (!m_grid->inBounds(s.x, s.y)) throw GridError("Checkpoint path leaves the grid");
+        }
+    }
+
+    for (const auto& v : cp.visits) {
+        if (!m_grid->inBounds(v.x, v.y)) throw GridError("Checkpoint visit outside the grid");
+        m_grid->markVisited(v.x, v.y, v.t);
+    }
+    for (std::size_t i = 0; i < m_drones.size(); ++i) {
+        m_drones[i].restore(cp.drones[i].path, m_cfg.totalSteps);
     }
+
+    m_cfg.firstStep    = cp.step + 1;
+    m_cfg.initialScore = cp.score;
+    m_resumed          = true;
+    m_resumeBase       = std::move(cp);
 }
 
 void GridHandler::run()
@@ -70,12 +234,100 @@ void GridHandler::run()
         throw AlgoError("Grid not loaded");
     }
 
-    initializeDrones();
+    if (!m_resumed) {
+        initializeDrones();
+    }
 
     try {
-        auto result = m_gridAlgo->run(*m_grid, std::span<Drone>(m_drones), m_cfg);
-        io::write_json(std::cout, result);
+        GridAlgoConfig cfg = m_cfg;
+        ObserverSet observers;
+        std::unique_ptr<CheckpointWriter> checkpoints;
+        if (m_checkpointEvery > 0) {
+            // A fresh run hashes the map on the writer thread, once any
+            // pipelined load is done; a resumed one already checked it.
+            std::shared_future<std::uint64_t> hash;
+            if (!m_resumed) {
+                std::shared_future<void> loaded = m_load ? m_load->loaded : std::shared_future<void>{};
+                hash = std::async(std::launch::deferred, [loaded, grid = m_grid.get()] {
+                    if (loaded.valid()) loaded.get();
+                    return mapHash(*grid);
+                }).share();
+            }
+            checkpoints = std::make_unique<CheckpointWriter>(
+                m_checkpointPath, m_resumed ? m_resumeBase : initialCheckpoint(), std::move(hash));
+            observers.add(checkpoints.get(), m_checkpointEvery);
+        }
+        std::unique_ptr<JsonPathWriter> output;
+        if (m_pipelined && !m_cfg.summaryOnly) {   // a summary has no paths to stream
+            output = std::make_unique<JsonPathWriter>();
+            observers.add(output.get(), JsonPathWriter::kEvery);
+        }
+        if (!observers.empty()) {
+            cfg.observer     = &observers;
+            cfg.observeEvery = observers.cadence();
+        }
+
+        RunResult result;
+        try {
+            if (m_load) {
+                // The planner would wait for these itself; waiting here makes
+                // planStart the time to first move.
+                for (const auto& drone : m_drones) {
+                    m_load->progress.waitForRow(std::min(m_grid->N - 1, drone.pos().y + Grid::kPad));
+                }
+            }
+            m_profile.planStart = Clock::now();
+            result = m_gridAlgo->run(*m_grid, std::span<Drone>(m_drones), cfg);
+        } catch (const std::exception&) {
+            finishLoad();   // a failed background load is the real cause
+            throw;
+        }
+        m_profile.planDone = Clock::now();
+        // Malformed rows past the planned area still fail the run, as in
+        // sequential mode, so the loader is joined before anything is printed.
+        finishLoad();
+        if (checkpoints) {
+            checkpoints->finish();
+        }
+
+        if (m_validating) {
+            const ScoreCheck check = validateRun(*m_grid, result, m_cfg.allowStay);
+            if (!check.ok) {
+                throw AlgoError("Score validation failed: " + check.error);
+            }
+            std::cerr << "[validate] score " << check.score << " matches the regrowth model\n";
+        }
+
+        if (output) {
+            output->finish(m_drones, result, std::cout);
+        } else {
+            io::write_json(std::cout, result);
+        }
+        std::cout.flush();
+        m_profile.outputDone = Clock::now();
+    } catch (const GridError&) {
+        throw;
     } catch (const std::exception& e) {
         throw AlgoError(std::string("Algorithm failed: ") + e.what());
     }
+
+    if (m_profiling) {
+        printProfile();
+    }
+}
+
+void GridHandler::printProfile() const
+{
+    const auto ms = [this](Clock::time_point t) {
+        return std::chrono::duration<double, std::milli>(t - m_profile.start).count();
+    };
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    ss << "[profile] " << (m_pipelined ? "pipelined" : "sequential")
+       << ": grid ready " << ms(m_profile.gridReady)
+       << " ms, first move " << ms(m_profile.planStart)
+       << " ms, load done " << ms(m_profile.loadDone)
+       << " ms, planning done " << ms(m_profile.planDone)
+       << " ms, output done " << ms(m_profile.outputDone) << " ms\n";
+    std::cerr << ss.str();
 }
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <future>
 #include <memory>
+#include <thread>
 #include <vector>
 #include <span>
 
@@ -8,6 +13,8 @@
 #include "struct/Drone.h"
 #include "struct/Grid.h"
 #include "struct/GridAlgoConfig.h"
+#include "struct/LoadProgress.h"
+#include "Checkpoint.h"
 #include "interfaces/IGridLoader.h"
 #include "interfaces/IGridAlgo.h"
 
@@ -23,6 +30,25 @@ public:
     void loadGrid();   // may throw
     void run();        // may throw
 
+    // Write a checkpoint to `path` every `every` steps during run().
+    void enableCheckpoints(std::filesystem::path path, int every);
+    // Continue from a checkpoint instead of step 0; call after loadGrid().
+    // Refuses a checkpoint written for another map or other settings.
+    void resumeFrom(const std::filesystem::path& path);  // may throw
+    // Planner and regrowth settings recorded in checkpoints and checked by
+    // resumeFrom(); call before either.
+    void setRunIdentity(RunIdentity identity);
+
+    // Overlap loading, planning and output: loadGrid() returns once the grid
+    // is allocated, rows keep loading in the background, and run() formats
+    // paths on a writer thread while planning. Call before loadGrid().
+    void enablePipelining();
+    // Print phase timings to stderr at the end of run().
+    void enableProfiling();
+    // Re-simulate the result (see validateRun) before printing it; run()
+    // throws if the paths and scores do not match the regrowth model.
+    void enableValidation();
+
     GridHandler(const GridHandler&) = delete;
     GridHandler& operator=(const GridHandler&) = delete;
     GridHandler(GridHandler&&) noexcept = default;
@@ -30,6 +56,27 @@ public:
 
 private:
     void initializeDrones();
+    [[nodiscard]] Checkpoint initialCheckpoint() const;
+    void startPipelinedLoad();
+    void finishLoad();   // joins a pipelined load; throws if it failed
+    void printProfile() const;
+
+    using Clock = std::chrono::steady_clock;
+
+    // Loader thread state; on the heap so the handler stays movable
+    struct PipelinedLoad {
+        LoadProgress       progress;
+        std::thread        thread;
+        std::exception_ptr error;
+        Clock::time_point  done;
+        std::promise<void>       finished;   // set when the loader returns
+        std::shared_future<void> loaded;
+    };
+
+    // Phase timestamps for --profile
+    struct Profile {
+        Clock::time_point start, gridReady, loadDone, planStart, planDone, outputDone;
+    };
 
 private:
     std::unique_ptr<IGridLoader> m_gridLoader;
@@ -38,4 +85,16 @@ private:
 
     std::vector<Drone>           m_drones;
     GridAlgoConfig               m_cfg;
+
+    std::filesystem::path        m_checkpointPath;
+    int                          m_checkpointEvery = 0;
+    RunIdentity                  m_identity;
+    bool                         m_resumed = false;
+    Checkpoint                   m_resumeBase;
+
+    bool                           m_pipelined = false;
+    bool                           m_profiling = false;
+    bool                           m_validating = false;
+    std::unique_ptr<PipelinedLoad> m_load;
+    Profile                        m_profile;
 };
@@ -0,0 +1,93 @@
+#include "JsonPathWriter.h"
+#include <string_view>
+#include <utility>
+#include "io/json.h"
+#include "struct/Drone.h"
+
+JsonPathWriter::JsonPathWriter()
+    : m_worker([this] { workerLoop(); })
+{
+}
+
+JsonPathWriter::~JsonPathWriter() {
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_one();
+    if (m_worker.joinable()) m_worker.join();
+}
+
+void JsonPathWriter::onStep(int /*tNow*/, long long /*totalScore*/, std::span<const Drone> drones) {
+    handOver(drones);
+}
+
+void JsonPathWriter::handOver(std::span<const Drone> drones) {
+    Batch batch;
+    {
+        std::lock_guard lock(m_mutex);
+        if (!m_spare.empty()) {
+            batch = std::move(m_spare.back());
+            m_spare.pop_back();
+        }
+    }
+    if (m_sent.size() < drones.size()) m_sent.resize(drones.size(), 0);
+    batch.resize(drones.size());
+    for (std::size_t i = 0; i < drones.size(); ++i) {
+        const auto& path = drones[i].path();
+        batch[i].assign(path.begin() + static_cast<std::ptrdiff_t>(m_sent[i]), path.end());
+        m_sent[i] = path.size();
+    }
+    {
+        std::lock_guard lock(m_mutex);
+        m_queue.push_back(std::move(batch));
+    }
+    m_cv.notify_one();
+}
+
+void JsonPathWriter::finish(std::span<const Drone> drones, const RunResult& result, std::ostream& os) {
+    handOver(drones);
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_one();
+    if (m_worker.joinable()) m_worker.join();
+    if (m_error) std::rethrow_exception(std::exchange(m_error, nullptr));
+
+    io::write_json_with(os, result, [this](std::size_t i) -> std::string_view {
+        return i < m_items.size() ? std::string_view(m_items[i]) : std::string_view();
+    });
+}
+
+void JsonPathWriter::workerLoop() {
+    std::vector<Batch> pending;
+    for (;;) {
+        {
+            std::unique_lock lock(m_mutex);
+            m_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+            if (m_queue.empty()) return;   // stopping and drained
+            pending.swap(m_queue);
+        }
+        if (!m_error) {
+            try {
+                for (const auto& batch : pending) {
+                    if (m_items.size() < batch.size()) m_items.resize(batch.size());
+                    for (std::size_t i = 0; i < batch.size(); ++i) {
+                        io::append_path_items(m_items[i], batch[i], /*first=*/m_items[i].empty());
+                    }
+                }
+            } catch (...) {
+                m_error = std::current_exception();
+            }
+        }
+        {
+            std::lock_guard lock(m_mutex);
+            for (auto& b : pending) {
+                if (m_spare.size() >= 2) break;
+                m_spare.push_back(std::move(b));
+            }
+        }
+        pending.clear();
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <ostream>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+#include "interfaces/IRunObserver.h"
+#include "struct/Result.h"
+#include "struct/Step.h"
+
+// Formats the "path" arrays of the JSON result on a background thread while
+// the planner is still running, so only the short header is left to write
+// once planning ends. Output is byte-identical to io::write_json.
+class JsonPathWriter final : public IRunObserver {
+public:
+    // Suggested onStep cadence: large enough that hand-off costs vanish,
+    // small enough that the formatter keeps pace with the planner.
+    static constexpr int kEvery = 1024;
+
+    JsonPathWriter();
+    ~JsonPathWriter() override;
+
+    JsonPathWriter(const JsonPathWriter&) = delete;
+    JsonPathWriter& operator=(const JsonPathWriter&) = delete;
+
+    void onStep(int tNow, long long totalScore, std::span<const Drone> drones) override;
+
+    // Hands over the steps added since the last onStep, waits for the
+    // formatter and writes the full result document.
+    void finish(std::span<const Drone> drones, const RunResult& result, std::ostream& os);
+
+private:
+    using Batch = std::vector<std::vector<Step>>;   // new steps per drone
+
+    void handOver(std::span<const Drone> drones);
+    void workerLoop();
+
+    std::vector<std::size_t>    m_sent;     // per drone: steps already handed over
+    std::vector<std::string>    m_items;    // per drone: formatted path entries (worker-owned)
+
+    std::mutex                  m_mutex;
+    std::condition_variable     m_cv;
+    std::vector<Batch>          m_queue;
+    std::vector<Batch>          m_spare;    // formatted batches, buffers kept for reuse
+    bool                        m_stop = false;
+    std::exception_ptr          m_error;
+    std::thread                 m_worker;
+};
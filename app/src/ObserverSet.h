@@ -0,0 +1,34 @@
+#pragma once
+#include <numeric>
+#include <span>
+#include <vector>
+#include "interfaces/IRunObserver.h"
+
+// Fans one planner observer slot out to several observers, each with its
+// own cadence. Install it with observeEvery = cadence().
+class ObserverSet final : public IRunObserver {
+public:
+    void add(IRunObserver* observer, int every) {
+        if (!observer || every <= 0) return;
+        m_entries.push_back(Entry{ observer, every });
+        m_cadence = std::gcd(m_cadence, every);
+    }
+
+    // Step interval that reaches every observer's own cadence; 0 when empty
+    [[nodiscard]] int  cadence() const noexcept { return m_cadence; }
+    [[nodiscard]] bool empty()   const noexcept { return m_entries.empty(); }
+
+    void onStep(int tNow, long long totalScore, std::span<const Drone> drones) override {
+        for (const auto& e : m_entries) {
+            if (tNow % e.every == 0) e.observer->onStep(tNow, totalScore, drones);
+        }
+    }
+
+private:
+    struct Entry {
+        IRunObserver* observer;
+        int           every;
+    };
+    std::vector<Entry> m_entries;
+    int                m_cadence = 0;
+};
@@ -0,0 +1,90 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "interfaces/IGridAlgo.h"
+#include "interfaces/IGridLoader.h"
+#include "struct/GridLoaderConfig.h"
+#include "struct/ParamBlock.h"
+
+// Shape of a job as seen by the planner cost model
+struct JobShape {
+    int  gridN        = 0;
+    int  drones       = 0;
+    int  totalSteps   = 0;
+    int  timeBudgetMs = 0;
+    int  horizon      = 1;
+    bool allowStay    = true;
+};
+
+// Estimated cost of a planner on a given job, in nanoseconds
+struct CostEstimate {
+    double setupNs        = 0.0; // one-off work before the first step
+    double perDroneStepNs = 0.0; // planning + collecting one drone for one step
+};
+
+struct PlannerEntry {
+    std::string name;
+    std::string description;
+    std::function<std::unique_ptr<IGridAlgo>(const ParamBlock&)>     create;
+    // Gets the same [algo.<name>] block as create(), since some settings
+    // change the cost as well as the plan.
+    std::function<CostEstimate(const JobShape&, const ParamBlock&)> cost;
+};
+
+struct LoaderEntry {
+    std::string name;
+    std::string description;
+    std::function<std::unique_ptr<IGridLoader>(const GridLoaderConfig&, const ParamBlock&)> create;
+};
+
+// Name -> planner factory. "auto" is reserved: it resolves to the planner with
+// the lowest predicted wall time once the grid and drones are known.
+class PlannerRegistry {
+public:
+    static constexpr std::string_view kAuto = "auto";
+
+    static PlannerRegistry& instance();
+
+    void add(PlannerEntry entry);
+
+    [[nodiscard]] const PlannerEntry* find(std::string_view name) const noexcept;
+    [[nodiscard]] const std::vector<PlannerEntry>& entries() const noexcept { return m_entries; }
+
+    // Throws std::runtime_error on unknown name or invalid parameters.
+    [[nodiscard]] std::unique_ptr<IGridAlgo> create(std::string_view name,
+                                                    const ParamSections& params) const;
+
+    // Predicted wall time of the whole job (capped by its time budget).
+    [[nodiscard]] static double predictMs(const PlannerEntry& entry, const JobShape& job,
+                                          const ParamSections& params = {});
+    [[nodiscard]] const PlannerEntry& fastest(const JobShape& job, const ParamSections& params = {}) const;
+
+private:
+    PlannerRegistry();
+
+    std::vector<PlannerEntry> m_entries;
+};
+
+// Name -> grid loader factory
+class LoaderRegistry {
+public:
+    static LoaderRegistry& instance();
+
+    void add(LoaderEntry entry);
+
+    [[nodiscard]] const LoaderEntry* find(std::string_view name) const noexcept;
+    [[nodiscard]] const std::vector<LoaderEntry>& entries() const noexcept { return m_entries; }
+
+    // Throws std::runtime_error on unknown name or invalid parameters.
+    [[nodiscard]] std::unique_ptr<IGridLoader> create(std::string_view name,
+                                                      const GridLoaderConfig& cfg,
+                                                      const ParamSections& params) const;
+
+private:
+    LoaderRegistry();
+
+    std::vector<LoaderEntry> m_entries;
+};
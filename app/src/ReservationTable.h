@@ -0,0 +1,48 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Which drone intends to reach each storage cell, and by which step. One
+// 64-bit word per cell: the claimed-until step in the high half, the owner
+// id + 1 in the low half (0 = unclaimed). Lock-free, so planners on any
+// number of threads may claim and read concurrently.
+//
+// Claims are advisory: a stale read only changes which move a planner
+// prefers, never what a move collects, so relaxed ordering is enough.
+class ReservationTable {
+public:
+    explicit ReservationTable(std::size_t cells) : m_cells(cells) {}
+
+    // Drone `owner` intends to reach cell k at step `until`. A claim for a
+    // later step replaces the current one; otherwise the first claim stands.
+    void claim(std::size_t k, int until, int owner) noexcept {
+        const std::uint64_t mine = pack(until, owner);
+        std::uint64_t cur = m_cells[k].load(std::memory_order_relaxed);
+        while (untilOf(cur) < static_cast<std::uint32_t>(until)) {
+            if (m_cells[k].compare_exchange_weak(cur, mine, std::memory_order_relaxed)) return;
+        }
+    }
+
+    // Claimed by a drone other than `self` for step t or later
+    [[nodiscard]] bool claimedByOther(std::size_t k, int t, int self) const noexcept {
+        const std::uint64_t cur = m_cells[k].load(std::memory_order_relaxed);
+        const std::uint64_t owner = cur & kOwnerMask;
+        return (untilOf(cur) >= static_cast<std::uint32_t>(t)) & (owner != 0)
+             & (owner != static_cast<std::uint32_t>(self) + 1u);
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return m_cells.size(); }
+
+private:
+    static constexpr std::uint64_t kOwnerMask = 0xffff'ffffu;
+
+    static std::uint64_t pack(int until, int owner) noexcept {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(until)) << 32)
+             | (static_cast<std::uint32_t>(owner) + 1u);
+    }
+    static std::uint32_t untilOf(std::uint64_t word) noexcept { return static_cast<std::uint32_t>(word >> 32); }
+
+    std::vector<std::atomic<std::uint64_t>> m_cells;
+};
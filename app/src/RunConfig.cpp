@@ -0,0 +1,265 @@
+#include "RunConfig.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+struct ConfigError : std::runtime_error { using std::runtime_error::runtime_error; };
+
+constexpr bool isBlank(char c) noexcept { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+} // namespace
+
+namespace config {
+
+// Plain loops: find_first_not_of() does a memchr per character here.
+std::string_view trim(std::string_view s) noexcept {
+    while (!s.empty() && isBlank(s.front())) s.remove_prefix(1);
+    while (!s.empty() && isBlank(s.back()))  s.remove_suffix(1);
+    return s;
+}
+
+namespace {
+template <class T>
+bool parseNumber(std::string_view s, T& out) noexcept {
+    if (!s.empty() && s.front() == '+') {
+        s.remove_prefix(1);
+        // from_chars would take the '-' of "+-5"
+        if (!s.empty() && (s.front() == '-' || s.front() == '+')) return false;
+    }
+    if (s.empty()) return false;
+    T v{};
+    const auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), v);
+    if (ec != std::errc() || end != s.data() + s.size()) return false;
+    out = v;
+    return true;
+}
+
+bool equalsNoCase(std::string_view a, std::string_view b) noexcept {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+        return std::tolower(static_cast<unsigned char>(x)) == y;
+    });
+}
+} // namespace
+
+bool parseInt(std::string_view s, int& out) noexcept    { return parseNumber(s, out); }
+bool parseDouble(std::string_view s, double& out) noexcept { return parseNumber(s, out); }
+
+bool parseBool(std::string_view s, bool& out) noexcept {
+    for (const auto t : { "1", "true", "yes", "on" }) {
+        if (equalsNoCase(s, t)) { out = true;  return true; }
+    }
+    for (const auto f : { "0", "false", "no", "off" }) {
+        if (equalsNoCase(s, f)) { out = false; return true; }
+    }
+    return false;
+}
+
+bool parsePosition(std::string_view s, Position& out) noexcept {
+    const auto comma = s.find(',');
+    if (comma == std::string_view::npos) return false;
+    Position p{};
+    if (!parseInt(trim(s.substr(0, comma)), p.x) || !parseInt(trim(s.substr(comma + 1)), p.y)) return false;
+    out = p;
+    return true;
+}
+
+bool parseLayout(std::string_view s, GridLayout& out) noexcept {
+    if (s == "rowmajor") { out = GridLayout::RowMajor; return true; }
+    if (s == "tiled")    { out = GridLayout::Tiled;    return true; }
+    return false;
+}
+
+bool parseHugePages(std::string_view s, HugePages& out) noexcept {
+    if (s == "off")      { out = HugePages::Off;         return true; }
+    if (s == "thp")      { out = HugePages::Transparent; return true; }
+    if (s == "explicit") { out = HugePages::Explicit;    return true; }
+    return false;
+}
+
+} // namespace config
+
+std::string formatIssues(const std::vector<ConfigIssue>& issues, std::string_view source) {
+    std::string out;
+    for (const auto& i : issues) {
+        if (!out.empty()) out += '\n';
+        if (!source.empty()) {
+            out += source;
+            out += ':';
+            if (i.line > 0) { out += std::to_string(i.line); out += ':'; }
+            out += ' ';
+        }
+        if (!i.key.empty()) { out += i.key; out += ' '; }
+        out += i.message;
+    }
+    return out;
+}
+
+RunConfig::RunConfig(RunConfigDraft d)
+    : m_algo(std::move(d.algo))
+    , m_cfg(d.cfg)
+    , m_starts(std::move(d.starts))
+    , m_loaderName(std::move(d.loaderName))
+    , m_loader(std::move(d.loader))
+{
+}
+
+RunConfigDraft::RunConfigDraft(const RunConfig& base)
+    : algo(base.algo())
+    , cfg(base.algoConfig())
+    , starts(base.starts())
+    , loaderName(base.loaderName())
+    , loader(base.loader())
+    , m_inheritedStarts(true)
+{
+}
+
+bool RunConfigDraft::set(std::string_view key, std::string_view value,
+                         std::vector<ConfigIssue>& issues, int line) {
+    auto bad = [&](const char* expected) {
+        issues.push_back(ConfigIssue{ line, std::string(key),
+                                      std::string("expects ") + expected + ", got '" + std::string(value) + "'" });
+        return false;
+    };
+
+    if (key == "algo") {
+        algo.assign(value);
+    } else if (key == "steps") {
+        if (!config::parseInt(value, cfg.totalSteps)) return bad("an integer");
+    } else if (key == "time_ms") {
+        if (!config::parseInt(value, cfg.timeBudgetMs)) return bad("an integer");
+    } else if (key == "horizon") {
+        if (!config::parseInt(value, cfg.horizon)) return bad("an integer");
+    } else if (key == "allow_stay") {
+        if (!config::parseBool(value, cfg.allowStay)) return bad("a boolean");
+    } else if (key == "step_deadline_us") {
+        if (!config::parseInt(value, cfg.stepDeadlineUs)) return bad("an integer");
+    } else if (key == "summary") {
+        if (!config::parseBool(value, cfg.summaryOnly)) return bad("a boolean");
+    } else if (key == "start") {
+        Position p{};
+        if (!config::parsePosition(value, p)) return bad("x,y");
+        if (m_inheritedStarts) starts.clear();
+        m_inheritedStarts = false;
+        starts.push_back(p);
+    } else {
+        issues.push_back(ConfigIssue{ line, {}, "unknown key '" + std::string(key) + "'" });
+        return false;
+    }
+    return true;
+}
+
+bool RunConfigDraft::validate(std::vector<ConfigIssue>& issues, int line) const {
+    const auto before = issues.size();
+    auto check = [&](bool ok, const char* key, const char* message) {
+        if (!ok) issues.push_back(ConfigIssue{ line, key, message });
+    };
+    check(cfg.totalSteps > 0,                    "steps",   "must be a positive integer");
+    check(cfg.timeBudgetMs > 0,                  "time_ms", "must be a positive integer (milliseconds)");
+    check(cfg.horizon >= 1 && cfg.horizon <= 2,  "horizon", "must be 1 or 2");
+    check(cfg.stepDeadlineUs >= 0,               "step_deadline_us", "must be >= 0 (0 = none)");
+    check(!starts.empty(),                       "start",   "needs at least one drone position");
+    check(!algo.empty(),                         "algo",    "must not be empty");
+    check(!loaderName.empty(),                   "loader",  "must not be empty");
+    check(loader.regrowthRate >= 0.0 && loader.regrowthRate <= 1.0,
+                                                 "regrowth_rate", "must be in [0.0, 1.0]");
+    check(loader.storage.firstTouchThreads >= 1, "first_touch_threads", "must be a positive integer");
+    return issues.size() == before;
+}
+
+std::optional<RunConfig> RunConfigDraft::build(std::vector<ConfigIssue>& issues, int line) const& {
+    if (!validate(issues, line)) return std::nullopt;
+    return RunConfig(*this);
+}
+
+std::optional<RunConfig> RunConfigDraft::build(std::vector<ConfigIssue>& issues, int line) && {
+    if (!validate(issues, line)) return std::nullopt;
+    return RunConfig(std::move(*this));
+}
+
+std::vector<RunConfig> parseScenarios(std::string_view text, const RunConfig& defaults,
+                                      std::vector<ConfigIssue>& issues) {
+    std::vector<RunConfig> out;
+    out.reserve(static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n')) + 1);
+    std::optional<RunConfigDraft> block;   // open [[scenario]] block
+    int  blockLine = 0;
+    bool blockOk   = true;
+
+    auto closeBlock = [&] {
+        if (!block) return;
+        auto rc = std::move(*block).build(issues, blockLine);
+        if (rc && blockOk) out.push_back(std::move(*rc));
+        block.reset();
+    };
+
+    int lineNo = 0;
+    while (!text.empty()) {
+        ++lineNo;
+        const auto eol = text.find('\n');
+        std::string_view line = text.substr(0, eol);
+        text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+        if (const auto hash = line.find('#'); hash != std::string_view::npos) line = line.substr(0, hash);
+        line = config::trim(line);
+        if (line.empty()) continue;
+
+        if (line == "[[scenario]]") {
+            closeBlock();
+            block.emplace(defaults);
+            blockLine = lineNo;
+            blockOk   = true;
+            continue;
+        }
+        if (block) {
+            const auto eq = line.find('=');
+            if (eq == std::string_view::npos) {
+                issues.push_back(ConfigIssue{ lineNo, {}, "expected key = value, got '" + std::string(line) + "'" });
+                blockOk = false;
+                continue;
+            }
+            blockOk &= block->set(config::trim(line.substr(0, eq)), config::trim(line.substr(eq + 1)),
+                                  issues, lineNo);
+            continue;
+        }
+
+        // One-line scenario
+        RunConfigDraft draft(defaults);
+        bool ok = true;
+        while (!line.empty()) {
+            std::size_t end = 0;
+            while (end < line.size() && !isBlank(line[end])) ++end;
+            const std::string_view token = line.substr(0, end);
+            line = config::trim(line.substr(end));
+            const auto eq = token.find('=');
+            if (eq == std::string_view::npos) {
+                issues.push_back(ConfigIssue{ lineNo, {}, "expected key=value, got '" + std::string(token) + "'" });
+                ok = false;
+                continue;
+            }
+            ok &= draft.set(token.substr(0, eq), token.substr(eq + 1), issues, lineNo);
+        }
+        auto rc = std::move(draft).build(issues, lineNo);
+        if (rc && ok) out.push_back(std::move(*rc));
+    }
+    closeBlock();
+    return out;
+}
+
+std::vector<RunConfig> loadScenarios(const std::filesystem::path& path, const RunConfig& defaults) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw ConfigError("Failed to open scenarios file: " + path.string());
+    }
+    std::ostringstream text;
+    text << in.rdbuf();
+
+    std::vector<ConfigIssue> issues;
+    auto scenarios = parseScenarios(text.view(), defaults, issues);
+    if (!issues.empty()) {
+        throw ConfigError("Invalid scenarios file (" + std::to_string(issues.size()) + " problem"
+                          + (issues.size() == 1 ? "" : "s") + "):\n" + formatIssues(issues, path.string()));
+    }
+    return scenarios;
+}
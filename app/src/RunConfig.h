@@ -0,0 +1,100 @@
+#pragma once
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "struct/GridAlgoConfig.h"
+#include "struct/GridLoaderConfig.h"
+#include "struct/GridStorageConfig.h"
+#include "struct/Position.h"
+
+// Value parsers shared by the CLI, config.ini and scenario files. They use
+// std::from_chars, accept only a fully consumed value and never throw.
+namespace config {
+[[nodiscard]] std::string_view trim(std::string_view s) noexcept;
+[[nodiscard]] bool parseInt(std::string_view s, int& out) noexcept;
+[[nodiscard]] bool parseDouble(std::string_view s, double& out) noexcept;
+[[nodiscard]] bool parseBool(std::string_view s, bool& out) noexcept;          // 1/0, true/false, yes/no, on/off
+[[nodiscard]] bool parsePosition(std::string_view s, Position& out) noexcept;  // "x,y"
+[[nodiscard]] bool parseLayout(std::string_view s, GridLayout& out) noexcept;
+[[nodiscard]] bool parseHugePages(std::string_view s, HugePages& out) noexcept;
+} // namespace config
+
+// One problem found while reading settings. `key` is the setting it
+// concerns (empty if none), `line` its 1-based line in a file (0 if none).
+struct ConfigIssue {
+    int         line = 0;
+    std::string key;
+    std::string message;   // reads after the key: "must be 1 or 2"
+};
+
+// "<source>:<line>: <key> <message>", one issue per line
+[[nodiscard]] std::string formatIssues(const std::vector<ConfigIssue>& issues, std::string_view source);
+
+class RunConfigDraft;
+
+// Validated settings of one run: the planner, its GridAlgoConfig and drone
+// starts, plus the loader options. Only RunConfigDraft::build creates one,
+// so holders can rely on every field being in range and never re-check.
+class RunConfig {
+public:
+    [[nodiscard]] const std::string&           algo()       const noexcept { return m_algo; }
+    [[nodiscard]] const GridAlgoConfig&        algoConfig() const noexcept { return m_cfg; }
+    [[nodiscard]] const std::vector<Position>& starts()     const noexcept { return m_starts; }
+    [[nodiscard]] const std::string&           loaderName() const noexcept { return m_loaderName; }
+    [[nodiscard]] const GridLoaderConfig&      loader()     const noexcept { return m_loader; }
+
+private:
+    friend class RunConfigDraft;
+    explicit RunConfig(RunConfigDraft d);
+
+    std::string           m_algo;
+    GridAlgoConfig        m_cfg;
+    std::vector<Position> m_starts;
+    std::string           m_loaderName;
+    GridLoaderConfig      m_loader;
+};
+
+// Mutable settings on their way to a RunConfig. Fill the fields directly or
+// through set(); build() checks them all and reports every problem at once.
+class RunConfigDraft {
+public:
+    std::string           algo       = "greedy";
+    GridAlgoConfig        cfg;
+    std::vector<Position> starts;
+    std::string           loaderName = "text";
+    GridLoaderConfig      loader;
+
+    RunConfigDraft() = default;
+    // Starts from `base`; the first start set() then replaces its starts.
+    explicit RunConfigDraft(const RunConfig& base);
+
+    // Applies one per-run setting (algo, steps, time_ms, horizon,
+    // allow_stay, step_deadline_us, summary, start). Returns false and
+    // appends to `issues` for unknown keys or malformed values.
+    bool set(std::string_view key, std::string_view value, std::vector<ConfigIssue>& issues, int line = 0);
+
+    // Range checks; on failure appends to `issues` and returns nullopt.
+    // The rvalue overload moves the fields into the result.
+    [[nodiscard]] std::optional<RunConfig> build(std::vector<ConfigIssue>& issues, int line = 0) const&;
+    [[nodiscard]] std::optional<RunConfig> build(std::vector<ConfigIssue>& issues, int line = 0) &&;
+
+private:
+    bool validate(std::vector<ConfigIssue>& issues, int line) const;
+
+    bool m_inheritedStarts = false;
+};
+
+// Parses an array of scenarios, each overriding `defaults`. A scenario is
+// either one line of whitespace-separated key=value pairs, or a
+// `[[scenario]]` header followed by `key = value` lines, which run up to
+// the next header (so one-line scenarios go before the first block). '#'
+// starts a comment. Keeps going after errors, so `issues` ends up with
+// every problem in the text; scenarios with problems are left out.
+[[nodiscard]] std::vector<RunConfig> parseScenarios(std::string_view text, const RunConfig& defaults,
+                                                    std::vector<ConfigIssue>& issues);
+
+// parseScenarios on a file. Throws std::runtime_error listing every issue.
+[[nodiscard]] std::vector<RunConfig> loadScenarios(const std::filesystem::path& path,
+                                                   const RunConfig& defaults);
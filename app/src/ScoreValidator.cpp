@@ -0,0 +1,83 @@
+#include "ScoreValidator.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+std::string at(std::size_t drone, std::size_t step) {
+    return "drone " + std::to_string(drone) + " step " + std::to_string(step) + ": ";
+}
+
+} // namespace
+
+ScoreCheck validateRun(const Grid& grid, const RunResult& result, bool allowStay) {
+    ScoreCheck check;
+    auto fail = [&](std::string error) {
+        check.error = std::move(error);
+        return check;
+    };
+
+    std::size_t steps = 0;
+    for (std::size_t i = 0; i < result.paths.size(); ++i) {
+        const auto& path = result.paths[i].path;
+        if (i == 0) steps = path.size();
+        if (path.size() != steps) {
+            return fail("drone " + std::to_string(i) + " has " + std::to_string(path.size())
+                        + " steps, drone 0 has " + std::to_string(steps));
+        }
+        for (std::size_t j = 0; j < path.size(); ++j) {
+            const Step& s = path[j];
+            if (s.timeStep != static_cast<int>(j)) {
+                return fail(at(i, j) + "time " + std::to_string(s.timeStep) + ", expected " + std::to_string(j));
+            }
+            if (!grid.inBounds(s.x, s.y)) {
+                return fail(at(i, j) + "(" + std::to_string(s.x) + "," + std::to_string(s.y) + ") is off the map");
+            }
+            if (j == 0) continue;
+            const int dx = std::abs(s.x - path[j - 1].x), dy = std::abs(s.y - path[j - 1].y);
+            if (dx > 1 || dy > 1) {
+                return fail(at(i, j) + "jumps more than one cell");
+            }
+            // On a 1x1 map staying is the only move there is.
+            if (!allowStay && dx == 0 && dy == 0 && grid.N > 1) {
+                return fail(at(i, j) + "stays in place with staying disabled");
+            }
+        }
+    }
+
+    // Last visit per touched cell, keyed by row-major map index
+    std::unordered_map<std::uint64_t, TimeStep> lastVisit;
+    lastVisit.reserve(steps * result.paths.size());
+    for (std::size_t t = 0; t < steps; ++t) {
+        for (std::size_t i = 0; i < result.paths.size(); ++i) {
+            const Step& s = result.paths[i].path[t];
+            const std::size_t k = grid.idx(s.x, s.y);
+            const long long b   = grid.base[k];
+            const long long inc = grid.inc[k];
+
+            long long value = b;
+            const auto [it, fresh] = lastVisit.try_emplace(Grid::idx(s.x, s.y, grid.N), static_cast<TimeStep>(t));
+            if (!fresh) {
+                const long long since = static_cast<long long>(t) - it->second;
+                value = since <= 0 ? 0 : std::min(b, inc * since);
+                it->second = static_cast<TimeStep>(t);
+            }
+            if (value != s.valueCollected) {
+                return fail(at(i, t) + "collected " + std::to_string(s.valueCollected)
+                            + ", regrowth model gives " + std::to_string(value));
+            }
+            check.score += value;
+        }
+    }
+
+    if (check.score != result.totalScore) {
+        return fail("reported score " + std::to_string(result.totalScore)
+                    + ", paths add up to " + std::to_string(check.score));
+    }
+    check.ok = true;
+    return check;
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <string>
+#include "struct/Grid.h"
+#include "struct/Result.h"
+
+// Outcome of re-simulating a run
+struct ScoreCheck {
+    bool        ok    = false;
+    long long   score = 0;    // total re-simulated from the paths
+    std::string error;        // first problem found; empty when ok
+};
+
+// Replays `result` on the map of `grid` under the regrowth model, without
+// using any planner or Grid value code: a cell yields its base on the first
+// visit, then min(base, inc * steps since the last visit), and 0 when it
+// was already visited in the same step. Drones move in path order within a
+// step. Checks that every path starts at t = 0 with consecutive steps,
+// stays on the map, moves at most one cell (and not in place unless
+// allowStay), and that each collected value and the total score match.
+// Only the grid's base and inc arrays are read, so a grid that was already
+// planned on can be checked.
+[[nodiscard]] ScoreCheck validateRun(const Grid& grid, const RunResult& result, bool allowStay);
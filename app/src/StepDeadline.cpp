@@ -0,0 +1,181 @@
+#include "StepDeadline.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace {
+
+// Steps are planned against the deadline minus a slack that tracks the
+// 99th percentile of how far a step overran its plan (the estimates are
+// running means). The slack starts at this share of the deadline and moves
+// by kSlackStep of the deadline per step: up by 0.995 of that after an
+// overrun larger than the slack, down by 0.005 otherwise. Aiming a little
+// above p99 keeps scheduler spikes, which no slack absorbs, inside the 1%.
+constexpr double kInitialSlack = 0.2;
+constexpr double kSlackStep    = 1.0 / 64.0;
+constexpr double kSlackQuantile = 0.995;
+// Weight of a new sample in the running cost means, and the most a single
+// sample may exceed them by (a preempted drone says nothing about the next)
+constexpr double kAlpha   = 1.0 / 16.0;
+constexpr double kOutlier = 4.0;
+
+// Display bins of the reported histogram, as multiples of the deadline
+constexpr double kBinEdges[] = { 0.125, 0.25, 0.5, 0.75, 1.0, 1.25, 1.5, 2.0, 4.0 };
+
+void blend(double& mean, double sample) noexcept {
+    mean = mean == 0.0 ? sample : mean + kAlpha * (std::min(sample, kOutlier * mean) - mean);
+}
+
+} // namespace
+
+std::size_t LatencyHistogram::bucketOf(std::uint64_t ns) noexcept {
+    if (ns < static_cast<std::uint64_t>(kSub)) return static_cast<std::size_t>(ns);
+    const int shift = std::bit_width(ns) - 1 - kSubBits;
+    const std::uint64_t mantissa = ns >> shift;   // in [kSub, 2*kSub)
+    return static_cast<std::size_t>(shift + 1) * kSub + static_cast<std::size_t>(mantissa - kSub);
+}
+
+std::int64_t LatencyHistogram::upperBound(std::size_t bucket) noexcept {
+    if (bucket < static_cast<std::size_t>(kSub)) return static_cast<std::int64_t>(bucket);
+    const int shift = static_cast<int>(bucket / kSub) - 1;
+    const std::uint64_t mantissa = bucket % kSub + kSub;
+    return static_cast<std::int64_t>(((mantissa + 1) << shift) - 1);
+}
+
+void LatencyHistogram::add(std::int64_t ns) noexcept {
+    ns = std::max<std::int64_t>(ns, 0);
+    ++m_buckets[bucketOf(static_cast<std::uint64_t>(ns))];
+    ++m_count;
+    m_max = std::max(m_max, ns);
+}
+
+std::int64_t LatencyHistogram::quantile(double q) const noexcept {
+    if (m_count == 0) return 0;
+    const auto target = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(m_count)));
+    std::uint64_t seen = 0;
+    for (std::size_t b = 0; b < m_buckets.size(); ++b) {
+        seen += m_buckets[b];
+        if (seen >= target && seen > 0) return std::min(upperBound(b), m_max);
+    }
+    return m_max;
+}
+
+std::uint64_t LatencyHistogram::countAtMost(std::int64_t ns) const noexcept {
+    std::uint64_t n = 0;
+    for (std::size_t b = 0; b < m_buckets.size() && upperBound(b) <= ns; ++b) n += m_buckets[b];
+    return n;
+}
+
+StepDeadline::StepDeadline(std::chrono::nanoseconds deadline, std::size_t drones, bool shallowIsFull)
+    : m_deadlineNs(static_cast<double>(deadline.count()))
+    , m_shallowIsFull(shallowIsFull)
+    , m_plan(drones, Level::Full)
+    , m_slackNs(m_deadlineNs * kInitialSlack)
+{
+}
+
+double StepDeadline::estimate(Level level) const noexcept {
+    if (level == Level::Shallow && m_shallowIsFull) level = Level::Full;
+    return m_costNs[static_cast<std::size_t>(level)];
+}
+
+void StepDeadline::beginStep() {
+    const std::size_t n = m_plan.size();
+    const double dn      = static_cast<double>(n);
+    m_budgetNs = m_deadlineNs - m_slackNs - m_overheadNs;
+    const double budget  = m_budgetNs;
+    const double full    = estimate(Level::Full);
+    const double shallow = estimate(Level::Shallow);
+    const double cached  = estimate(Level::Cached);
+
+    // How many drones can take the more expensive level when the others
+    // all take the cheaper one
+    auto fit = [n](double room, double extra) -> std::size_t {
+        if (room <= 0.0) return 0;
+        if (extra <= 0.0) return n;
+        return std::min(n, static_cast<std::size_t>(room / extra));
+    };
+    std::size_t nFull = n, nShallow = 0;
+    if (dn * full > budget) {
+        if (m_shallowIsFull) {
+            nFull = fit(budget - dn * cached, full - cached);
+        } else if (dn * shallow <= budget) {
+            nFull    = fit(budget - dn * shallow, full - shallow);
+            nShallow = n - nFull;
+        } else {
+            nFull    = 0;
+            nShallow = fit(budget - dn * cached, shallow - cached);
+        }
+    }
+
+    m_remainingNs = 0.0;
+    for (std::size_t j = 0; j < n; ++j) {
+        const Level level = j < nFull ? Level::Full : j < nFull + nShallow ? Level::Shallow : Level::Cached;
+        m_plan[(m_rotate + j) % n] = level;
+        m_remainingNs += estimate(level);
+    }
+    // Drones cut back this step go first next step.
+    if (n > 0) m_rotate = (m_rotate + nFull) % n;
+}
+
+StepDeadline::Level StepDeadline::levelFor(std::size_t i, Clock::duration elapsed) noexcept {
+    Level level = m_plan[i];
+    // Late means the rest of the plan would overrun the budget beginStep()
+    // planned against, slack included, not just the deadline itself.
+    const double late = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count())
+                      + m_remainingNs - m_budgetNs;
+    m_remainingNs -= estimate(level);
+    if (late > 0.0 && level != Level::Cached) {
+        level = (level == Level::Full && !m_shallowIsFull) ? Level::Shallow : Level::Cached;
+    }
+    m_plannedNs += estimate(level);
+    return level;
+}
+
+void StepDeadline::record(Level level, Clock::duration cost) noexcept {
+    const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(cost).count());
+    blend(m_costNs[static_cast<std::size_t>(level)], ns);
+    m_droneNsThisStep += ns;
+    if (level != Level::Full) m_degraded = true;
+    if (level == Level::Shallow) ++m_shallowPlans;
+    if (level == Level::Cached)  ++m_cachedMoves;
+}
+
+void StepDeadline::endStep(Clock::duration stepTime) noexcept {
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(stepTime).count();
+    m_latency.add(ns);
+    const double overrun = static_cast<double>(ns) - (m_overheadNs + m_plannedNs);
+    m_slackNs += kSlackStep * m_deadlineNs * (overrun > m_slackNs ? kSlackQuantile : kSlackQuantile - 1.0);
+    m_slackNs  = std::clamp(m_slackNs, 0.0, m_deadlineNs);
+    blend(m_overheadNs, std::max(0.0, static_cast<double>(ns) - m_droneNsThisStep));
+    if (m_degraded) ++m_degradedSteps;
+    if (static_cast<double>(ns) > m_deadlineNs) ++m_missedSteps;
+    m_degraded        = false;
+    m_droneNsThisStep = 0.0;
+    m_plannedNs       = 0.0;
+}
+
+StepLatency StepDeadline::report() const {
+    StepLatency r;
+    r.deadlineUs    = static_cast<int>(m_deadlineNs / 1000.0);
+    r.steps         = static_cast<long long>(m_latency.count());
+    r.degradedSteps = m_degradedSteps;
+    r.missedSteps   = m_missedSteps;
+    r.shallowPlans  = m_shallowPlans;
+    r.cachedMoves   = m_cachedMoves;
+    r.p50Us = static_cast<double>(m_latency.quantile(0.50)) / 1000.0;
+    r.p99Us = static_cast<double>(m_latency.quantile(0.99)) / 1000.0;
+    r.maxUs = static_cast<double>(m_latency.max()) / 1000.0;
+
+    std::uint64_t below = 0;
+    for (const double edge : kBinEdges) {
+        const std::uint64_t atMost = m_latency.countAtMost(static_cast<std::int64_t>(edge * m_deadlineNs));
+        r.histogram.push_back(StepLatency::Bucket{ edge * m_deadlineNs / 1000.0,
+                                                   static_cast<long long>(atMost - below) });
+        below = atMost;
+    }
+    if (below < m_latency.count()) {
+        r.histogram.push_back(StepLatency::Bucket{ r.maxUs, static_cast<long long>(m_latency.count() - below) });
+    }
+    return r;
+}
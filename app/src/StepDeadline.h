@@ -0,0 +1,86 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "struct/Result.h"
+
+// Log-linear histogram of durations in nanoseconds: 32 buckets per power of
+// two, so a reported percentile is within ~3% of the true value.
+class LatencyHistogram {
+public:
+    void add(std::int64_t ns) noexcept;
+
+    [[nodiscard]] std::uint64_t count() const noexcept { return m_count; }
+    [[nodiscard]] std::int64_t  max()   const noexcept { return m_max; }
+    // Upper bound of the bucket holding the q-quantile (0 < q <= 1)
+    [[nodiscard]] std::int64_t  quantile(double q) const noexcept;
+    // Samples <= ns (exact at bucket edges, else rounded down to one)
+    [[nodiscard]] std::uint64_t countAtMost(std::int64_t ns) const noexcept;
+
+private:
+    static constexpr int kSubBits = 5;
+    static constexpr int kSub     = 1 << kSubBits;
+    static constexpr int kBuckets = (64 - kSubBits + 1) * kSub;
+
+    static std::size_t  bucketOf(std::uint64_t ns) noexcept;
+    static std::int64_t upperBound(std::size_t bucket) noexcept;
+
+    std::array<std::uint64_t, kBuckets> m_buckets{};
+    std::uint64_t m_count = 0;
+    std::int64_t  m_max   = 0;
+};
+
+// Per-step planning deadline (GridAlgoConfig::stepDeadlineUs). Keeps running
+// estimates of what one drone costs when planned at full horizon, at
+// horizon 1 and when it just repeats its previous move. Before each step
+// it gives as many drones as fit the full horizon, then horizon 1, and the
+// rest their cached move. Which drones are cut back rotates from step to
+// step, so every drone recovers the full horizon as soon as there is room.
+// A drone is cut back one more level if the step is running late. The
+// budget leaves a slack that tracks the p99 of how far steps overran their
+// estimate, so p99 step time stays under the deadline as long as the
+// deadline is above what a step costs with every drone repeating its move.
+class StepDeadline {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Level : std::uint8_t { Full, Shallow, Cached };
+
+    // shallowIsFull: the run is horizon 1 already, so there is no Shallow
+    StepDeadline(std::chrono::nanoseconds deadline, std::size_t drones, bool shallowIsFull);
+
+    void  beginStep();
+    // Level for drone i, given how long the step has taken so far
+    [[nodiscard]] Level levelFor(std::size_t i, Clock::duration elapsed) noexcept;
+    // What a drone actually cost at the level it was planned with
+    void  record(Level level, Clock::duration cost) noexcept;
+    void  endStep(Clock::duration stepTime) noexcept;
+
+    [[nodiscard]] StepLatency report() const;
+
+private:
+    [[nodiscard]] double estimate(Level level) const noexcept;
+
+    double            m_deadlineNs;
+    bool              m_shallowIsFull;
+    std::vector<Level> m_plan;          // per drone, this step
+    std::size_t       m_rotate = 0;     // first drone offered the full horizon
+    double            m_budgetNs = 0.0;     // drone planning time this step
+    double            m_remainingNs = 0.0;  // estimate of the drones not yet planned
+    double            m_plannedNs = 0.0;    // estimate of the drones planned so far
+    double            m_slackNs;            // ~p99 of step time over its estimate
+    bool              m_degraded = false;
+
+    // Running means (ns); 0 until first measured
+    std::array<double, 3> m_costNs{};
+    double                m_overheadNs = 0.0;   // per step, outside drone planning
+    double                m_droneNsThisStep = 0.0;
+
+    LatencyHistogram m_latency;
+    long long        m_degradedSteps = 0;
+    long long        m_missedSteps   = 0;
+    long long        m_shallowPlans  = 0;
+    long long        m_cachedMoves   = 0;
+};
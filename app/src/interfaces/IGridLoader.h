@@ -1,6 +1,8 @@
 #pragma once
 
 #include <memory>
+#include <stdexcept>
+#include "../struct/LoadProgress.h"
 
 class Grid;
 
@@ -9,4 +11,16 @@ public:
     virtual ~IGridLoader() = default;
     
     [[nodiscard]] virtual std::unique_ptr<Grid> loadGrid() const = 0;
-};
\ No newline at end of file
+
+    // Streams the grid into `progress`: publishes it as soon as it is
+    // allocated, then rows as they are parsed. Runs on a background thread in
+    // pipelined mode; errors are thrown, not reported through `progress`.
+    // The default loads everything first and then publishes it complete.
+    virtual void loadGridStreaming(LoadProgress& progress) const {
+        auto grid = loadGrid();
+        if (!grid) throw std::runtime_error("Loader returned null grid");
+        const int n = grid->N;
+        progress.publishGrid(std::move(grid));
+        progress.publishRows(n);
+    }
+};
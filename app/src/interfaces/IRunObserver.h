@@ -0,0 +1,14 @@
+#pragma once
+#include <span>
+
+class Drone;
+
+// Receives the run state from inside a planner's step loop. Called on the
+// planning thread, so implementations must return quickly.
+class IRunObserver {
+public:
+    virtual ~IRunObserver() = default;
+
+    // Every drone has collected step tNow; totalScore includes it.
+    virtual void onStep(int tNow, long long totalScore, std::span<const Drone> drones) = 0;
+};
@@ -4,12 +4,48 @@
 #include <sstream>
 #include <locale>
 #include <algorithm>
+#include <charconv>
+#include <span>
+#include <string>
+#include <string_view>
 #include "../struct/Result.h"
 
 namespace io {
 
-inline std::ostream& write_json(std::ostream& os, const RunResult& r,
-                                bool pretty = true, int indent_size = 2) {
+namespace detail {
+inline void append_int(std::string& out, long long v) {
+    char buf[24];
+    const auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), v);
+    out.append(buf, end);
+}
+} // namespace detail
+
+// Appends entries of a drone's "path" array exactly as write_json prints
+// them. Entries are preceded by their separator, so a path can be formatted
+// in pieces: pass first = true only for the piece that starts the array.
+inline void append_path_items(std::string& out, std::span<const Step> steps, bool first,
+                              bool pretty = true, int indent_size = 2) {
+    const std::string_view nl = pretty ? "\n" : "";
+    const std::string_view sp = pretty ? " "  : "";
+    const std::size_t indent = pretty ? 4 * static_cast<std::size_t>(std::max(0, indent_size)) : 0;
+
+    for (const auto& s : steps) {
+        if (!first) { out += ','; out += nl; }
+        first = false;
+        out.append(indent, ' ');
+        out += "{\"t\":";      out += sp; detail::append_int(out, s.timeStep);
+        out += ',';  out += sp; out += "\"x\":"; out += sp; detail::append_int(out, s.x);
+        out += ',';  out += sp; out += "\"y\":"; out += sp; detail::append_int(out, s.y);
+        out += ',';  out += sp; out += "\"value\":"; out += sp; detail::append_int(out, s.valueCollected);
+        out += '}';
+    }
+}
+
+// Writes r with each drone's path entries taken from pathItems(i), which
+// returns what append_path_items produced for r.paths[i].
+template <class PathItems>
+std::ostream& write_json_with(std::ostream& os, const RunResult& r, PathItems&& pathItems,
+                              bool pretty = true, int indent_size = 2) {
     const char* nl = pretty ? "\n" : "";
     const char* sp = pretty ? " "  : "";
     const std::string indent_unit(pretty ? std::max(0, indent_size) : 0, ' ');
@@ -22,6 +58,41 @@ inline std::ostream& write_json(std::ostream& os, const RunResult& r,
     indent(1); os << "\"score\":" << sp << r.totalScore << "," << nl;
     indent(1); os << "\"drones\":" << sp << r.drones << "," << nl;
     indent(1); os << "\"time_elapsed_ms\":" << sp << r.timeElapsedMs << "," << nl;
+    if (const auto& l = r.stepLatency) {
+        indent(1); os << "\"step_latency\":" << sp << "{" << nl;
+        indent(2); os << "\"deadline_us\":"    << sp << l->deadlineUs    << "," << nl;
+        indent(2); os << "\"steps\":"          << sp << l->steps         << "," << nl;
+        indent(2); os << "\"degraded_steps\":" << sp << l->degradedSteps << "," << nl;
+        indent(2); os << "\"missed_steps\":"   << sp << l->missedSteps   << "," << nl;
+        indent(2); os << "\"shallow_plans\":"  << sp << l->shallowPlans  << "," << nl;
+        indent(2); os << "\"cached_moves\":"   << sp << l->cachedMoves   << "," << nl;
+        indent(2); os << "\"p50_us\":"         << sp << l->p50Us         << "," << nl;
+        indent(2); os << "\"p99_us\":"         << sp << l->p99Us         << "," << nl;
+        indent(2); os << "\"max_us\":"         << sp << l->maxUs         << "," << nl;
+        indent(2); os << "\"histogram\":" << sp << "[";
+        for (std::size_t i = 0; i < l->histogram.size(); ++i) {
+            os << (i ? "," : "") << "{\"le_us\":" << sp << l->histogram[i].leUs
+               << "," << sp << "\"count\":" << sp << l->histogram[i].count << "}";
+        }
+        os << "]" << nl;
+        indent(1); os << "}," << nl;
+    }
+
+    if (const auto& m = r.summary) {
+        // Summary mode: no paths to print
+        indent(1); os << "\"summary\":" << sp << "{" << nl;
+        indent(2); os << "\"steps\":"          << sp << m->steps         << "," << nl;
+        indent(2); os << "\"distinct_cells\":" << sp << m->distinctCells << "," << nl;
+        indent(2); os << "\"value_histogram\":" << sp << "[";
+        for (std::size_t i = 0; i < m->valueHistogram.size(); ++i) {
+            os << (i ? "," : "") << "{\"le\":" << sp << ((1LL << i) - 1)
+               << "," << sp << "\"count\":" << sp << m->valueHistogram[i] << "}";
+        }
+        os << "]" << nl;
+        indent(1); os << "}" << nl;
+        os << "}" << nl;
+        return os;
+    }
 
     indent(1); os << "\"paths\":" << sp << "[" << nl;
     for (std::size_t i = 0; i < r.paths.size(); ++i) {
@@ -32,18 +103,8 @@ inline std::ostream& write_json(std::ostream& os, const RunResult& r,
         indent(3); os << "\"steps\":"    << sp << p.path.size() << "," << nl;
 
         indent(3); os << "\"path\":" << sp << "[" << nl;
-        for (std::size_t j = 0; j < p.path.size(); ++j) {
-            const auto& s = p.path[j];
-            indent(4);
-            os << "{"
-               << "\"t\":"     << sp << s.timeStep << ","
-               << sp << "\"x\":" << sp << s.x       << ","
-               << sp << "\"y\":" << sp << s.y       << ","
-               << sp << "\"value\":" << sp << s.valueCollected
-               << "}";
-            if (j + 1 < p.path.size()) os << ",";
-            os << nl;
-        }
+        const std::string_view items = pathItems(i);
+        if (!items.empty()) os << items << nl;
         indent(3); os << "]" << nl;
 
         indent(2); os << "}";
@@ -56,6 +117,43 @@ inline std::ostream& write_json(std::ostream& os, const RunResult& r,
     return os;
 }
 
+inline std::ostream& write_json(std::ostream& os, const RunResult& r,
+                                bool pretty = true, int indent_size = 2) {
+    std::string items;
+    return write_json_with(os, r, [&](std::size_t i) -> std::string_view {
+        items.clear();
+        append_path_items(items, r.paths[i].path, /*first=*/true, pretty, indent_size);
+        return items;
+    }, pretty, indent_size);
+}
+
+// Merged batch results: totals, then one compact result object per line
+inline std::ostream& write_batch_json(std::ostream& os, const BatchReport& b) {
+    os << "{\n"
+       << "  \"scenarios\": " << b.outcomes.size() << ",\n"
+       << "  \"failed\": "    << b.failed << ",\n"
+       << "  \"total_score\": " << b.totalScore << ",\n"
+       << "  \"results\": [\n";
+    for (std::size_t i = 0; i < b.outcomes.size(); ++i) {
+        const auto& o = b.outcomes[i];
+        os << "    {\"scenario\": " << o.scenario;
+        if (o.ok) {
+            os << ", \"status\": \"ok\", \"result\": ";
+            write_json(os, o.result, /*pretty=*/false);
+        } else {
+            os << ", \"status\": \"failed\", \"error\": \"";
+            for (const char c : o.error) {
+                if (c == '"' || c == '\\') os << '\\';
+                if (static_cast<unsigned char>(c) >= 0x20) os << c;
+            }
+            os << "\"";
+        }
+        os << "}" << (i + 1 < b.outcomes.size() ? "," : "") << "\n";
+    }
+    os << "  ]\n}\n";
+    return os;
+}
+
 inline std::string to_json(const RunResult& r, bool pretty = true, int indent_size = 2) {
     std::ostringstream oss;
     write_json(oss, r, pretty, indent_size);
@@ -1,10 +1,12 @@
+#include <chrono>
 #include <iostream>
 #include <memory>
+#include "BatchCoordinator.h"
 #include "CLIOptions.h"
 #include "GridHandler.h"
-#include "GridFileLoader.h"
-#include "struct/GridAlgoConfig.h"
-#include "GridAlgo.h"
+#include "PlannerRegistry.h"
+#include "RunConfig.h"
+#include "io/json.h"
 
 
 int main(int argc, char** argv) {
@@ -15,16 +17,48 @@ int main(int argc, char** argv) {
             return 0;
         }
 
-        std::vector<Position> startPositions = { { opt.startX(), opt.startY() } };
+        const RunConfig& run = opt.runConfig();
+        GridLoaderConfig loaderConfig = run.loader();
+        // Batch workers share the loader's arrays instead of a copy of them.
+        loaderConfig.storage.sharedMap = !opt.scenariosPath().empty();
+        std::unique_ptr<IGridLoader> loader =
+            LoaderRegistry::instance().create(run.loaderName(), loaderConfig, opt.params());
 
-        std::unique_ptr<IGridLoader> loader = std::make_unique<GridFileLoader>(opt.filePath(),
-                                                       opt.regrowthRate());
+        if (!opt.scenariosPath().empty()) {
+            const auto t0 = std::chrono::steady_clock::now();
+            const auto scenarios = loadScenarios(opt.scenariosPath(), run);
+            if (opt.profile()) {
+                const double ms = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - t0).count();
+                std::cerr << "[profile] parsed " << scenarios.size() << " scenarios in " << ms << " ms ("
+                          << (ms > 0.0 ? scenarios.size() / ms * 1000.0 : 0.0) << " configs/s)\n";
+            }
+            BatchCoordinator batch(loader->loadGrid(), opt.params(), opt.workers());
+            const BatchReport report = batch.run(scenarios);
+            io::write_batch_json(std::cout, report);
+            if (report.failed > 0) {
+                std::cerr << "[error] " << report.failed << " of " << report.outcomes.size()
+                          << " scenarios failed\n";
+                return 1;
+            }
+            return 0;
+        }
 
-        GridAlgoConfig cfg{ opt.totalSteps(), opt.timeBudgetMs(), opt.horizon(), opt.allowStay() };
-        std::unique_ptr<IGridAlgo> algo = std::make_unique<GridAlgo>();
-        GridHandler handler(std::move(loader), std::move(algo), startPositions, cfg);
+        std::unique_ptr<IGridAlgo> algo =
+            PlannerRegistry::instance().create(run.algo(), opt.params());
+        GridHandler handler(std::move(loader), std::move(algo), run.starts(), run.algoConfig());
 
+        if (opt.pipeline()) handler.enablePipelining();
+        if (opt.profile())  handler.enableProfiling();
+        if (opt.validate()) handler.enableValidation();
+        handler.setRunIdentity(RunIdentity{ run.algo(), plannerParams(opt.params()), run.loader().regrowthRate });
         handler.loadGrid();
+        if (opt.checkpointEvery() > 0) {
+            handler.enableCheckpoints(opt.checkpointPath(), opt.checkpointEvery());
+        }
+        if (!opt.resumePath().empty()) {
+            handler.resumeFrom(opt.resumePath());
+        }
         handler.run();
         return 0;
 
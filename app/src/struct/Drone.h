@@ -18,11 +18,23 @@ public:
         if (stepsHint > 0) m_path.reserve(static_cast<size_t>(stepsHint));
     }
 
+    // Continue from a previously recorded path (checkpoint resume).
+    void restore(std::vector<Step> path, int stepsHint = 0) {
+        m_path = std::move(path);
+        if (stepsHint > 0) m_path.reserve(static_cast<size_t>(stepsHint));
+        m_pos  = m_path.empty() ? m_start : Position{ m_path.back().x, m_path.back().y };
+    }
+
     void moveTo(int newX, int newY, TimeStep timeStep, CellValue valueCollected) {
         m_pos = {newX, newY};
         m_path.push_back(Step{timeStep, newX, newY, valueCollected});
     }
 
+    // Moves without recording a Step (summary runs keep no path)
+    void moveUnrecorded(int newX, int newY) noexcept {
+        m_pos = {newX, newY};
+    }
+
     struct Move { int dx; int dy; };
 
     static std::span<const Move> moves8(bool allowStay) noexcept {
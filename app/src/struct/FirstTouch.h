@@ -0,0 +1,98 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// How the Grid's storage arrays are split between threads for first-touch
+// NUMA placement. Part i is the same range of storage indices in every
+// array and belongs to the i-th CPU the process may run on (wrapping when
+// there are more parts than CPUs). run() writes each part from a thread
+// pinned to that CPU, so all of its pages land on that CPU's node; a
+// planner thread that calls pin(i) then works on local memory.
+class FirstTouch {
+public:
+    // Parts are whole multiples of this many cells, so each part starts on
+    // a page boundary in every array, whatever its element size.
+    static constexpr std::size_t kAlignCells = 4096;
+
+    FirstTouch(std::size_t cells, int threads) : m_cells(cells) {
+        const std::size_t want = static_cast<std::size_t>(std::max(1, threads));
+        const std::size_t even = (cells + want - 1) / want;
+        m_chunk = std::max(kAlignCells, (even + kAlignCells - 1) / kAlignCells * kAlignCells);
+        m_parts = (cells + m_chunk - 1) / m_chunk;
+#if defined(__linux__)
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (::sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &allowed)) m_cpus.push_back(cpu);
+            }
+        }
+#endif
+    }
+
+    [[nodiscard]] std::size_t parts() const noexcept { return m_parts; }
+
+    // Storage indices [first, second) of part i
+    [[nodiscard]] std::pair<std::size_t, std::size_t> range(std::size_t part) const noexcept {
+        const std::size_t begin = std::min(m_cells, part * m_chunk);
+        return { begin, std::min(m_cells, begin + m_chunk) };
+    }
+
+    // CPU that part i is written from; -1 where affinity is unavailable
+    [[nodiscard]] int cpuOf(std::size_t part) const noexcept {
+        return m_cpus.empty() ? -1 : m_cpus[part % m_cpus.size()];
+    }
+
+    // Pins the calling thread to cpuOf(part); false if that is not possible
+    bool pin(std::size_t part) const noexcept {
+#if defined(__linux__)
+        const int cpu = cpuOf(part);
+        if (cpu < 0) return false;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+#else
+        (void)part;
+        return false;
+#endif
+    }
+
+    // Calls f(begin, end) for every part, each on its own thread pinned with
+    // pin(part), and joins them. A single part runs on the calling thread.
+    template <class F>
+    void run(F&& f) const {
+        if (m_parts <= 1) {
+            if (m_parts == 1) f(std::size_t{0}, m_cells);
+            return;
+        }
+        std::vector<std::thread> workers;
+        workers.reserve(m_parts);
+        try {
+            for (std::size_t part = 0; part < m_parts; ++part) {
+                workers.emplace_back([this, &f, part] {
+                    pin(part);
+                    const auto [begin, end] = range(part);
+                    f(begin, end);
+                });
+            }
+        } catch (...) {
+            for (auto& w : workers) w.join();
+            throw;
+        }
+        for (auto& w : workers) w.join();
+    }
+
+private:
+    std::size_t      m_cells;
+    std::size_t      m_chunk = kAlignCells;
+    std::size_t      m_parts = 0;
+    std::vector<int> m_cpus;   // CPUs the process may run on, ascending
+};
@@ -1,85 +1,173 @@
 #pragma once
-#include <vector>
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <limits>
 #include <stdexcept>
 #include <utility>
+#include "FirstTouch.h"
+#include "GridArray.h"
+#include "GridStorageConfig.h"
 
 using CellValue = int;
 using TimeStep  = int;
 
+class LoadProgress;
+
 class Grid {
 public:
+    // Width of the sentinel ring in padded storage; matches the maximum
+    // planner lookahead (horizon 2).
+    static constexpr int kPad = 2;
+
+    // Base value of sentinel cells. Negative enough that no path through a
+    // sentinel ever beats a real cell, small enough that two-step sums of
+    // sentinels cannot overflow.
+    static constexpr CellValue kSentinel = std::numeric_limits<CellValue>::min() / 4;
+
+    // Tiled layout: kTile x kTile blocks, so one tile of one array is a single
+    // 64-byte cache line and a 5x5 lookahead touches 4 lines instead of 5 rows.
+    static constexpr int kTileShift = 2;
+    static constexpr int kTile      = 1 << kTileShift;
+    static constexpr int kTileMask  = kTile - 1;
+
+    // Marks an out-of-map cell in neighbourhood()
+    static constexpr std::size_t kNoCell = std::numeric_limits<std::size_t>::max();
+
     Grid() = default;
 
     // Initialize grid storage to N x N. Throws on invalid N or overflow.
     void initialize(int n, CellValue defaultBase = 0, CellValue defaultInc = 0) {
+        initialize(n, GridStorageConfig{}, defaultBase, defaultInc);
+    }
+
+    void initialize(int n, const GridStorageConfig& storage,
+                    CellValue defaultBase = 0, CellValue defaultInc = 0) {
         if (n <= 0) throw std::runtime_error("Grid::initialize: N must be positive");
-        const std::size_t Nsz = static_cast<std::size_t>(n);
-        // overflow-safe check for N*N
-        if (Nsz > std::numeric_limits<std::size_t>::max() / Nsz) {
+        const int p = storage.padded ? kPad : 0;
+        if (n > std::numeric_limits<int>::max() - 2 * p - kTile) {
             throw std::runtime_error("Grid::initialize: N too large (overflow)");
         }
-        const std::size_t total = Nsz * Nsz;
+        const int extent = n + 2 * p;
+        const int tiles  = (extent + kTileMask) >> kTileShift;
+        const std::size_t Ssz = static_cast<std::size_t>(
+            storage.layout == GridLayout::Tiled ? tiles * kTile : extent);
+        // overflow-safe check for side*side
+        if (Ssz > std::numeric_limits<std::size_t>::max() / Ssz) {
+            throw std::runtime_error("Grid::initialize: N too large (overflow)");
+        }
+        const std::size_t total = Ssz * Ssz;
 
-        N = n;
-        base.assign(total, defaultBase);
-        inc.assign(total, defaultInc);
-        lastVisitTime.assign(total, -1);
+        N           = n;
+        pad         = p;
+        stride      = extent;
+        layout      = storage.layout;
+        tilesPerRow = tiles;
+        touchThreads = std::max(1, storage.firstTouchThreads);
+        const bool fillInterior = p != 0;
+        base.allocate(total, storage.hugePages, storage.sharedMap);
+        inc.allocate(total, storage.hugePages, storage.sharedMap);
+        lastVisitTime.allocate(total, storage.hugePages);
+        // Part i of all three arrays is first touched by the same pinned thread.
+        const CellValue fillBase = fillInterior ? kSentinel : defaultBase;
+        const CellValue fillInc  = fillInterior ? 0 : defaultInc;
+        firstTouch().run([&](std::size_t begin, std::size_t end) {
+            base.fill(fillBase, begin, end);
+            inc.fill(fillInc, begin, end);
+            lastVisitTime.fill(-1, begin, end);
+        });
+
+        if (fillInterior) {
+            for (int y = 0; y < N; ++y) {
+                for (int x = 0; x < N; ++x) {
+                    setCell(x, y, defaultBase, defaultInc);
+                }
+            }
+        }
     }
 
-    // Row-major index helpers
+    // Row-major index helper for an unpadded n x n array
     static constexpr std::size_t idx(int x, int y, int n) noexcept {
         return static_cast<std::size_t>(y) * static_cast<std::size_t>(n)
              + static_cast<std::size_t>(x);
     }
+    // Storage index of map cell (x,y); accounts for padding and layout
     constexpr std::size_t idx(int x, int y) const noexcept {
-        return idx(x, y, N);
+        const int px = x + pad, py = y + pad;
+        return layout == GridLayout::Tiled ? tiledIdx(px, py) : idx(px, py, stride);
+    }
+    // Storage index delta of a (dx,dy) step; row-major layout only
+    constexpr std::ptrdiff_t offset(int dx, int dy) const noexcept {
+        return static_cast<std::ptrdiff_t>(dy) * stride + dx;
+    }
+
+    // Storage indices of the (2R+1)x(2R+1) block centred on (x,y), row by row.
+    // Cells outside the map (and outside the sentinel ring) are kNoCell. In the
+    // tiled layout a block row is one or two runs of consecutive indices, so
+    // only tile crossings pay for a full index computation.
+    template <int R>
+    void neighbourhood(int x, int y, std::array<std::size_t, (2*R+1)*(2*R+1)>& out) const noexcept {
+        constexpr int side = 2 * R + 1;
+        for (int r = 0; r < side; ++r) {
+            const int cy = y - R + r;
+            std::size_t k = kNoCell;
+            for (int c = 0; c < side; ++c) {
+                const int cx = x - R + c;
+                const bool inStorage = cx >= -pad && cy >= -pad && cx < N + pad && cy < N + pad;
+                if (!inStorage) {
+                    k = kNoCell;
+                } else if (k == kNoCell || layout == GridLayout::RowMajor) {
+                    k = idx(cx, cy);
+                } else {
+                    k = ((cx + pad) & kTileMask) ? k + 1 : tiledIdx(cx + pad, cy + pad);
+                }
+                out[static_cast<std::size_t>(r * side + c)] = k;
+            }
+        }
     }
 
     [[nodiscard]] bool inBounds(int x, int y) const noexcept {
         return x >= 0 && y >= 0 && x < N && y < N;
     }
+    [[nodiscard]] bool padded() const noexcept { return pad != 0; }
+    [[nodiscard]] bool tiled()  const noexcept { return layout == GridLayout::Tiled; }
+    [[nodiscard]] GridBacking backing() const noexcept { return base.backing(); }
+    // How initialize() split the storage between first-touch threads; a
+    // thread working on part i should pin itself with pin(i).
+    [[nodiscard]] FirstTouch firstTouch() const { return FirstTouch(base.size(), touchThreads); }
 
-    // Collectible value at (x,y) given current time; never exceeds base.
-    [[nodiscard]] CellValue valueAt(int x, int y, TimeStep tNow) const {
+    void setCell(int x, int y, CellValue b, CellValue i) {
         const std::size_t k = idx(x, y);
-        const CellValue b   = base[k];
-        const TimeStep  lv  = lastVisitTime[k];
-
-        if (lv < 0) 
-        {
-            return b;
-        } // never visited
-        const long long stepsSince = static_cast<long long>(tNow) - static_cast<long long>(lv);
-        if (stepsSince <= 0) 
-        {
-            return 0;
-        }
+        base[k] = b;
+        inc[k]  = i;
+    }
 
-        const long long grow = static_cast<long long>(inc[k]) * stepsSince;
-        return static_cast<CellValue>(grow >= b ? b : grow);
+    // Collectible value at (x,y) given current time; never exceeds base.
+    [[nodiscard]] CellValue valueAt(int x, int y, TimeStep tNow) const {
+        return valueAtIndex(idx(x, y), tNow);
     }
 
     // Same as valueAt but with temporary override for a single cell's last-visit time
     [[nodiscard]] CellValue valueAtWithOverride(
         int x, int y, TimeStep tNow, std::size_t overrideIndex, TimeStep overrideLV
-    ) const 
+    ) const
     {
-        const std::size_t k = idx(x, y);
-        const CellValue b   = base[k];
-        const TimeStep  lv  = (k == overrideIndex) ? overrideLV : lastVisitTime[k];
-
-        if (lv < 0) return b;
-        const long long stepsSince = static_cast<long long>(tNow) - static_cast<long long>(lv);
-        if (stepsSince <= 0) return 0;
+        return valueAtIndexWithOverride(idx(x, y), tNow, overrideIndex, overrideLV);
+    }
 
-        const long long grow = static_cast<long long>(inc[k]) * stepsSince;
-        return static_cast<CellValue>(grow >= b ? b : grow);
+    // Storage-index forms of the above, for kernels that walk by offset()
+    [[nodiscard]] CellValue valueAtIndex(std::size_t k, TimeStep tNow) const noexcept {
+        return regrown(k, lastVisitTime[k], tNow);
+    }
+    [[nodiscard]] CellValue valueAtIndexWithOverride(
+        std::size_t k, TimeStep tNow, std::size_t overrideIndex, TimeStep overrideLV
+    ) const noexcept
+    {
+        return regrown(k, (k == overrideIndex) ? overrideLV : lastVisitTime[k], tNow);
     }
 
     void markVisited(int x, int y, TimeStep t) {
-        if (!inBounds(x, y)) 
+        if (!inBounds(x, y))
         {
             throw std::out_of_range("Grid::markVisited: out of bounds");
         }
@@ -92,7 +180,40 @@ public:
     [[nodiscard]] std::pair<int,int> dimensions() const noexcept { return {N, N}; }
 
     int N = 0;
-    std::vector<CellValue> base;
-    std::vector<CellValue> inc;
-    std::vector<TimeStep>  lastVisitTime;
+    int pad = 0;     // sentinel ring width (0 or kPad)
+    int stride = 0;  // N + 2*pad
+    GridLayout layout = GridLayout::RowMajor;
+    int tilesPerRow = 0;
+    int touchThreads = 1;   // GridStorageConfig::firstTouchThreads
+    GridArray<CellValue> base;
+    GridArray<CellValue> inc;
+    GridArray<TimeStep>  lastVisitTime;
+
+    // Set while a pipelined loader is still filling rows; planners must wait
+    // for the rows they read (see LoadProgress).
+    const LoadProgress* loading = nullptr;
+
+private:
+    constexpr std::size_t tiledIdx(int px, int py) const noexcept {
+        const std::size_t tile = static_cast<std::size_t>(py >> kTileShift) * static_cast<std::size_t>(tilesPerRow)
+                               + static_cast<std::size_t>(px >> kTileShift);
+        return (tile << (2 * kTileShift))
+             | static_cast<std::size_t>(((py & kTileMask) << kTileShift) | (px & kTileMask));
+    }
+
+    CellValue regrown(std::size_t k, TimeStep lv, TimeStep tNow) const noexcept {
+        const CellValue b = base[k];
+        if (lv < 0)
+        {
+            return b;
+        } // never visited
+        const long long stepsSince = static_cast<long long>(tNow) - static_cast<long long>(lv);
+        if (stepsSince <= 0)
+        {
+            return 0;
+        }
+
+        const long long grow = static_cast<long long>(inc[k]) * stepsSince;
+        return static_cast<CellValue>(grow >= b ? b : grow);
+    }
 };
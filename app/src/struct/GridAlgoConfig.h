@@ -1,9 +1,28 @@
 #pragma once
 
+class IRunObserver;
+
 // Configuration parameters for grid-based algorithms
 struct GridAlgoConfig {
     int  totalSteps   = 1;
     int  timeBudgetMs = 0;  
     int  horizon      = 1;   
     bool allowStay    = true;
-};
\ No newline at end of file
+
+    // Per-step planning deadline in microseconds, 0 = none. Drones that do
+    // not fit are planned at horizon 1 or repeat their previous move.
+    int  stepDeadlineUs = 0;
+
+    // Score-only run: drones record no paths and RunResult carries a
+    // RunSummary instead, so memory stays O(grid) whatever the step count.
+    bool summaryOnly = false;
+
+    // Resume support: steps before firstStep are already applied to the grid
+    // and drone paths, and initialScore is what they collected.
+    int       firstStep    = 0;
+    long long initialScore = 0;
+
+    // Optional, not owned: notified after every observeEvery-th step.
+    IRunObserver* observer     = nullptr;
+    int           observeEvery = 0;
+};
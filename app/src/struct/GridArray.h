@@ -0,0 +1,174 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+#include "GridStorageConfig.h"
+
+// Where the memory behind a GridArray actually came from
+enum class GridBacking { None, Heap, Pages, TransparentHuge, ExplicitHuge, Shared };
+
+// Fixed-size array of trivially copyable cells for the Grid. Unlike
+// std::vector it does not touch its memory on allocation, so filling it
+// from several threads places pages on the NUMA node of the thread that
+// writes them first, and it can ask the kernel for huge pages.
+template <class T>
+class GridArray {
+    static_assert(std::is_trivially_copyable_v<T>, "GridArray holds plain cell data");
+
+public:
+    static constexpr std::size_t kAlign        = 64;              // one cache line
+    static constexpr std::size_t kPageSize     = 4096;
+    static constexpr std::size_t kHugePageSize = std::size_t{2} << 20;
+
+    GridArray() = default;
+    ~GridArray() { release(); }
+
+    GridArray(const GridArray&) = delete;
+    GridArray& operator=(const GridArray&) = delete;
+
+    GridArray(GridArray&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr))
+        , m_size(std::exchange(other.m_size, 0))
+        , m_bytes(std::exchange(other.m_bytes, 0))
+        , m_backing(std::exchange(other.m_backing, GridBacking::None)) {}
+
+    GridArray& operator=(GridArray&& other) noexcept {
+        if (this != &other) {
+            release();
+            m_data    = std::exchange(other.m_data, nullptr);
+            m_size    = std::exchange(other.m_size, 0);
+            m_bytes   = std::exchange(other.m_bytes, 0);
+            m_backing = std::exchange(other.m_backing, GridBacking::None);
+        }
+        return *this;
+    }
+
+    // Replaces the contents with n uninitialised elements. Huge-page requests
+    // degrade to transparent huge pages, then to normal pages, when the
+    // kernel refuses them. A shared array is anonymous shared memory that
+    // processes forked later see (and keep seeing) in place of a copy.
+    // Throws std::bad_alloc if no memory is available.
+    void allocate(std::size_t n, HugePages policy = HugePages::Off, bool shared = false) {
+        release();
+        if (n == 0) return;
+        if (n > static_cast<std::size_t>(-1) / sizeof(T)) throw std::bad_alloc();
+        const std::size_t bytes = n * sizeof(T);
+
+#if defined(__linux__)
+        if (shared) {
+            const std::size_t unit = policy == HugePages::Off ? kPageSize : kHugePageSize;
+            const std::size_t len  = (bytes + unit - 1) / unit * unit;
+            void* p = MAP_FAILED;
+            if (policy == HugePages::Explicit) {
+                p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            }
+            if (p == MAP_FAILED) {
+                p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+                if (p == MAP_FAILED) throw std::bad_alloc();
+                if (policy != HugePages::Off) ::madvise(p, len, MADV_HUGEPAGE);
+            }
+            adopt(p, n, len, GridBacking::Shared);
+            return;
+        }
+        if (policy != HugePages::Off) {
+            const std::size_t len = (bytes + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+            if (policy == HugePages::Explicit) {
+                void* p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if (p != MAP_FAILED) {
+                    adopt(p, n, len, GridBacking::ExplicitHuge);
+                    return;
+                }
+            }
+            void* p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) throw std::bad_alloc();
+            const bool thp = ::madvise(p, len, MADV_HUGEPAGE) == 0;
+            adopt(p, n, len, thp ? GridBacking::TransparentHuge : GridBacking::Pages);
+            return;
+        }
+#else
+        (void)policy;
+        (void)shared;
+#endif
+        adopt(::operator new(bytes, std::align_val_t{kAlign}), n, bytes, GridBacking::Heap);
+    }
+
+#if defined(__linux__)
+    // Replaces the contents with a read-only view of n elements stored at
+    // `offset` (page aligned) in the shared memory object `fd`. Writing
+    // through the view faults. Throws std::bad_alloc if mapping fails.
+    void mapShared(int fd, std::size_t offset, std::size_t n) {
+        release();
+        if (n == 0) return;
+        const std::size_t bytes = n * sizeof(T);
+        void* p = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, static_cast<off_t>(offset));
+        if (p == MAP_FAILED) throw std::bad_alloc();
+        adopt(p, n, bytes, GridBacking::Shared);
+    }
+
+    // Makes a shared array read-only in this process and every process
+    // forked from it afterwards; writing through it then faults. False if
+    // the array is not shared or the kernel refuses.
+    bool makeReadOnly() noexcept {
+        if (m_backing != GridBacking::Shared || !m_data) return false;
+        return ::mprotect(m_data, m_bytes, PROT_READ) == 0;
+    }
+#endif
+
+    // Writes value to every element, or to [begin, end). Writing a range
+    // first-touches its pages; see FirstTouch for splitting that by thread.
+    void fill(T value) noexcept { fill(value, 0, m_size); }
+    void fill(T value, std::size_t begin, std::size_t end) noexcept {
+        std::fill(m_data + begin, m_data + end, value);
+    }
+
+    [[nodiscard]] T&       operator[](std::size_t k) noexcept       { return m_data[k]; }
+    [[nodiscard]] const T& operator[](std::size_t k) const noexcept { return m_data[k]; }
+
+    [[nodiscard]] T*          data()    noexcept       { return m_data; }
+    [[nodiscard]] const T*    data()    const noexcept { return m_data; }
+    [[nodiscard]] T*          begin()   noexcept       { return m_data; }
+    [[nodiscard]] T*          end()     noexcept       { return m_data + m_size; }
+    [[nodiscard]] const T*    begin()   const noexcept { return m_data; }
+    [[nodiscard]] const T*    end()     const noexcept { return m_data + m_size; }
+    [[nodiscard]] std::size_t size()    const noexcept { return m_size; }
+    [[nodiscard]] bool        empty()   const noexcept { return m_size == 0; }
+    [[nodiscard]] GridBacking backing() const noexcept { return m_backing; }
+
+private:
+    void adopt(void* p, std::size_t n, std::size_t bytes, GridBacking backing) noexcept {
+        m_data    = static_cast<T*>(p);
+        m_size    = n;
+        m_bytes   = bytes;
+        m_backing = backing;
+    }
+
+    void release() noexcept {
+        if (!m_data) return;
+        if (m_backing == GridBacking::Heap) {
+            ::operator delete(m_data, std::align_val_t{kAlign});
+        }
+#if defined(__linux__)
+        else {
+            ::munmap(m_data, m_bytes);
+        }
+#endif
+        m_data    = nullptr;
+        m_size    = 0;
+        m_bytes   = 0;
+        m_backing = GridBacking::None;
+    }
+
+    T*          m_data    = nullptr;
+    std::size_t m_size    = 0;
+    std::size_t m_bytes   = 0;
+    GridBacking m_backing = GridBacking::None;
+};
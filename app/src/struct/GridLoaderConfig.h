@@ -0,0 +1,10 @@
+#pragma once
+#include <filesystem>
+#include "GridStorageConfig.h"
+
+// Parameters shared by every grid loader implementation
+struct GridLoaderConfig {
+    std::filesystem::path file;
+    double                regrowthRate = 0.0;
+    GridStorageConfig     storage;
+};
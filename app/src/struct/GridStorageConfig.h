@@ -0,0 +1,31 @@
+#pragma once
+
+// Order of cells in the Grid's storage arrays
+enum class GridLayout {
+    RowMajor,  // y * stride + x
+    Tiled,     // 4x4 tiles (one 64-byte line per array), tiles row-major
+};
+
+// Page size requested for the Grid's storage arrays
+enum class HugePages {
+    Off,          // default heap allocation
+    Transparent,  // anonymous mapping + madvise(MADV_HUGEPAGE)
+    Explicit,     // MAP_HUGETLB, falling back to Transparent
+};
+
+// How a Grid lays out its cell arrays in memory
+struct GridStorageConfig {
+    // Surround the map with a ring of Grid::kPad sentinel cells so planner
+    // kernels can probe the whole lookahead window without bounds checks.
+    bool       padded = false;
+    GridLayout layout = GridLayout::RowMajor;
+    HugePages  hugePages = HugePages::Off;
+    // Threads that first-touch the arrays. Each writes one page-aligned
+    // slice of storage order (the same slice of every array) pinned to its
+    // own CPU, so on NUMA machines pages land on that CPU's node. See
+    // FirstTouch.
+    int        firstTouchThreads = 1;
+    // Put base and inc in anonymous shared memory, so worker processes
+    // forked after loading share the loader's only copy (batch mode).
+    bool       sharedMap = false;
+};
@@ -0,0 +1,65 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include "Grid.h"
+
+// Hand-off between a loader filling a Grid top to bottom on one thread and
+// planners reading it on another. Rows [0, rowsReady()) are complete.
+class LoadProgress {
+public:
+    // Loader side -------------------------------------------------------
+    // The grid is allocated (and initialised) but holds no rows yet.
+    void publishGrid(std::unique_ptr<Grid> grid) {
+        std::lock_guard lock(m_mutex);
+        m_raw  = grid.get();
+        m_grid = std::move(grid);
+        m_cv.notify_all();
+    }
+    void publishRows(int rows) {
+        m_ready.store(rows, std::memory_order_release);
+        std::lock_guard lock(m_mutex);
+        m_cv.notify_all();
+    }
+    void fail(std::exception_ptr error) {
+        std::lock_guard lock(m_mutex);
+        m_error = std::move(error);
+        m_cv.notify_all();
+    }
+
+    // Consumer side -----------------------------------------------------
+    // Blocks until the grid is allocated; throws if loading failed first.
+    Grid& waitForGrid() {
+        std::unique_lock lock(m_mutex);
+        m_cv.wait(lock, [&] { return m_raw || m_error; });
+        if (!m_raw) std::rethrow_exception(m_error);
+        return *m_raw;
+    }
+    // Ownership of the grid; the loader keeps writing rows into it.
+    std::unique_ptr<Grid> takeGrid() {
+        std::lock_guard lock(m_mutex);
+        return std::move(m_grid);
+    }
+
+    // Blocks until row `row` is loaded; throws if loading failed before it.
+    void waitForRow(int row) const {
+        if (row < m_ready.load(std::memory_order_acquire)) return;
+        std::unique_lock lock(m_mutex);
+        m_cv.wait(lock, [&] { return row < m_ready.load(std::memory_order_acquire) || m_error; });
+        if (row >= m_ready.load(std::memory_order_acquire)) std::rethrow_exception(m_error);
+    }
+
+    [[nodiscard]] int  rowsReady() const noexcept { return m_ready.load(std::memory_order_acquire); }
+    [[nodiscard]] bool complete()  const noexcept { return m_raw && rowsReady() >= m_raw->N; }
+
+private:
+    std::atomic<int>                m_ready{0};
+    mutable std::mutex              m_mutex;
+    mutable std::condition_variable m_cv;
+    std::unique_ptr<Grid>           m_grid;
+    Grid*                           m_raw = nullptr;
+    std::exception_ptr              m_error;
+};
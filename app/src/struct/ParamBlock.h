@@ -0,0 +1,10 @@
+#pragma once
+#include <map>
+#include <string>
+
+// Free-form key/value parameters of a single planner or loader, e.g. the
+// contents of an `[algo.greedy]` block in the config file.
+using ParamBlock = std::map<std::string, std::string>;
+
+// All parameter blocks, keyed by section name ("algo.greedy", "loader.text").
+using ParamSections = std::map<std::string, ParamBlock>;
@@ -1,4 +1,6 @@
 #pragma once
+#include <optional>
+#include <string>
 #include <vector>
 #include "Step.h"
 
@@ -8,10 +10,53 @@ struct DronePath {
     std::vector<Step>  path;
 };
 
+// Planning latency per step under a step deadline
+struct StepLatency {
+    // Steps whose latency fell in (previous leUs, leUs]
+    struct Bucket { double leUs; long long count; };
+
+    int       deadlineUs    = 0;
+    long long steps         = 0;
+    long long degradedSteps = 0;   // some drone planned below full horizon
+    long long missedSteps   = 0;   // took longer than the deadline
+    long long shallowPlans  = 0;   // drone-steps planned at horizon 1
+    long long cachedMoves   = 0;   // drone-steps that repeated the previous move
+    double    p50Us = 0.0;
+    double    p99Us = 0.0;
+    double    maxUs = 0.0;
+    std::vector<Bucket> histogram;
+};
+
+// Aggregate statistics of a run that kept no paths (GridAlgoConfig::summaryOnly)
+struct RunSummary {
+    long long steps         = 0;   // per drone, t = 0 included
+    long long distinctCells = 0;   // map cells visited at least once
+    // Drone-steps by collected value: bin 0 holds value 0, bin i values in
+    // [2^(i-1), 2^i). Trailing empty bins are dropped.
+    std::vector<long long> valueHistogram;
+};
+
 // Result of a full run with one or more drones
 struct RunResult {
     long long          totalScore   = 0;
     int                drones       = 0;
     int                timeElapsedMs= 0;
     std::vector<DronePath> paths;
+    std::optional<StepLatency> stepLatency;   // set when a step deadline was given
+    std::optional<RunSummary>  summary;       // set instead of paths in summary mode
+};
+
+// Outcome of one scenario of a batch run
+struct ScenarioOutcome {
+    int                scenario = 0;
+    bool               ok       = false;
+    RunResult          result;          // valid when ok
+    std::string        error;           // why not ok
+};
+
+// Merged results of a batch run, in scenario order
+struct BatchReport {
+    std::vector<ScenarioOutcome> outcomes;
+    long long          totalScore = 0;  // over successful scenarios
+    int                failed     = 0;
 };
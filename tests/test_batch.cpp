@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <csignal>
+#include <memory>
+#include <vector>
+#include "BatchCoordinator.h"
+#include "GridAlgo.h"
+#include "PlannerRegistry.h"
+#include "struct/Drone.h"
+#include "struct/Grid.h"
+#include "test_support.h"
+
+namespace {
+
+// Base 0-19, regrowing at a quarter of it per step
+std::unique_ptr<Grid> randomGrid(int n, unsigned seed, const GridStorageConfig& storage = {}) {
+    return std::make_unique<Grid>(test_support::makeGrid(n, seed, storage, 19, 4));
+}
+
+RunResult runAlone(const Scenario& sc, unsigned seed) {
+    auto grid = randomGrid(40, seed);
+    GridAlgo algo;
+    return test_support::runSwarm(algo, *grid, sc.starts(), sc.algoConfig());
+}
+
+void expectSameRun(const RunResult& a, const RunResult& b) {
+    EXPECT_EQ(a.totalScore, b.totalScore);
+    ASSERT_EQ(a.paths.size(), b.paths.size());
+    for (std::size_t i = 0; i < a.paths.size(); ++i) {
+        ASSERT_EQ(a.paths[i].path.size(), b.paths[i].path.size());
+        for (std::size_t j = 0; j < a.paths[i].path.size(); ++j) {
+            const auto& s = a.paths[i].path[j];
+            const auto& t = b.paths[i].path[j];
+            ASSERT_TRUE(s.timeStep == t.timeStep && s.x == t.x && s.y == t.y &&
+                        s.valueCollected == t.valueCollected) << "drone " << i << " step " << j;
+        }
+    }
+}
+
+Scenario build(const RunConfigDraft& draft) {
+    std::vector<ConfigIssue> issues;
+    auto sc = draft.build(issues);
+    EXPECT_TRUE(issues.empty()) << formatIssues(issues, "draft");
+    return *sc;
+}
+
+std::vector<Scenario> sweep() {
+    std::vector<Scenario> out;
+    for (int i = 0; i < 8; ++i) {
+        RunConfigDraft d;
+        d.cfg = GridAlgoConfig{ 300 + 50 * i, 1'000'000, 1 + i % 2, i % 3 != 0 };
+        d.starts = { { i, 39 - i } };
+        if (i % 4 == 1) d.starts.push_back({ 20, 20 });
+        out.push_back(build(d));
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(BatchTest, MatchesSingleProcessRuns) {
+    BatchCoordinator batch(randomGrid(40, 7u, GridStorageConfig{ true }), {}, 3);
+    EXPECT_EQ(batch.grid().backing(), GridBacking::Shared);
+
+    const auto scenarios = sweep();
+    const auto report = batch.run(scenarios);
+    ASSERT_EQ(report.outcomes.size(), scenarios.size());
+    EXPECT_EQ(report.failed, 0);
+
+    long long total = 0;
+    for (std::size_t i = 0; i < scenarios.size(); ++i) {
+        ASSERT_TRUE(report.outcomes[i].ok) << report.outcomes[i].error;
+        const auto alone = runAlone(scenarios[i], 7u);
+        expectSameRun(report.outcomes[i].result, alone);
+        total += alone.totalScore;
+    }
+    EXPECT_EQ(report.totalScore, total);
+}
+
+TEST(BatchTest, SharedLoadIsUsedInPlace) {
+    GridStorageConfig storage;
+    storage.sharedMap = true;
+    auto grid = randomGrid(40, 7u, storage);
+    const CellValue* base = grid->base.data();
+    const CellValue* inc  = grid->inc.data();
+
+    BatchCoordinator batch(std::move(grid), {}, 2);
+    EXPECT_EQ(batch.grid().base.data(), base);
+    EXPECT_EQ(batch.grid().inc.data(), inc);
+    EXPECT_EQ(batch.grid().backing(), GridBacking::Shared);
+
+    const auto scenarios = sweep();
+    const auto report = batch.run(scenarios);
+    ASSERT_EQ(report.failed, 0);
+    for (std::size_t i = 0; i < scenarios.size(); ++i) {
+        expectSameRun(report.outcomes[i].result, runAlone(scenarios[i], 7u));
+    }
+}
+
+TEST(BatchTest, CrashedWorkerFailsOnlyItsScenario) {
+    class Crash final : public IGridAlgo {
+        RunResult run(Grid&, std::span<Drone>, const GridAlgoConfig&) override {
+            std::raise(SIGKILL);
+            return {};
+        }
+    };
+    if (!PlannerRegistry::instance().find("test-crash")) {
+        PlannerRegistry::instance().add(PlannerEntry{ "test-crash", "kills its process",
+            [](const ParamBlock&) { return std::make_unique<Crash>(); },
+            [](const JobShape&, const ParamBlock&) { return CostEstimate{ 1e12, 1e12 }; } });
+    }
+
+    auto scenarios = sweep();
+    RunConfigDraft crash(scenarios[2]);
+    crash.algo = "test-crash";
+    scenarios[2] = build(crash);
+    RunConfigDraft offMap(scenarios[5]);
+    offMap.starts = { { 400, 0 } };   // reported by the worker, which survives
+    scenarios[5] = build(offMap);
+
+    BatchCoordinator batch(randomGrid(40, 7u), {}, 2);
+    const auto report = batch.run(scenarios);
+    EXPECT_EQ(report.failed, 2);
+    EXPECT_FALSE(report.outcomes[2].ok);
+    EXPECT_NE(report.outcomes[2].error.find("signal"), std::string::npos) << report.outcomes[2].error;
+    EXPECT_FALSE(report.outcomes[5].ok);
+    EXPECT_NE(report.outcomes[5].error.find("out of bounds"), std::string::npos) << report.outcomes[5].error;
+    for (std::size_t i : { 0u, 1u, 3u, 4u, 6u, 7u }) {
+        ASSERT_TRUE(report.outcomes[i].ok) << i << ": " << report.outcomes[i].error;
+        expectSameRun(report.outcomes[i].result, runAlone(scenarios[i], 7u));
+    }
+}
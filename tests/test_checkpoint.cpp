@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include "Checkpoint.h"
+#include "GridAlgo.h"
+#include "GridHandler.h"
+#include "interfaces/IGridLoader.h"
+#include "struct/Grid.h"
+
+namespace {
+
+class RandomGridLoader final : public IGridLoader {
+public:
+    RandomGridLoader(int n, unsigned seed) : m_n(n), m_seed(seed) {}
+
+    [[nodiscard]] std::unique_ptr<Grid> loadGrid() const override {
+        std::mt19937 rng(m_seed);
+        auto g = std::make_unique<Grid>();
+        g->initialize(m_n);
+        for (int y = 0; y < m_n; ++y) {
+            for (int x = 0; x < m_n; ++x) {
+                const int b = static_cast<int>(rng() % 10);
+                g->setCell(x, y, b, b / 3);
+            }
+        }
+        return g;
+    }
+
+private:
+    int      m_n;
+    unsigned m_seed;
+};
+
+std::string stripTiming(std::string json) {
+    const auto at = json.find("\"time_elapsed_ms\"");
+    return at == std::string::npos ? json : json.erase(at, json.find('\n', at) - at);
+}
+
+std::string runHandler(int steps, const std::filesystem::path& checkpoint, int every,
+                       const std::filesystem::path& resume, unsigned seed = 3u,
+                       const RunIdentity& identity = {}) {
+    GridAlgoConfig cfg{ steps, 1'000'000, 2, true };
+    GridHandler handler(std::make_unique<RandomGridLoader>(16, seed), std::make_unique<GridAlgo>(),
+                        { { 1, 2 }, { 12, 9 }, { 5, 5 } }, cfg);
+    handler.setRunIdentity(identity);
+    handler.loadGrid();
+    if (every > 0) handler.enableCheckpoints(checkpoint, every);
+    if (!resume.empty()) handler.resumeFrom(resume);
+    testing::internal::CaptureStdout();
+    handler.run();
+    return stripTiming(testing::internal::GetCapturedStdout());
+}
+
+std::filesystem::path tempPath(const std::string& name) {
+    return std::filesystem::temp_directory_path() / ("drone_swarm_" + name);
+}
+
+} // namespace
+
+TEST(CheckpointTest, SaveLoadRoundTrip) {
+    Checkpoint cp;
+    cp.gridN = 7; cp.horizon = 2; cp.allowStay = false; cp.step = 4; cp.score = 123;
+    cp.stepDeadlineUs = 250; cp.mapHash = 0x0123456789abcdefull;
+    cp.run = RunIdentity{ "greedy", { { "greedy.values", "eager" } }, 0.25 };
+    cp.drones.push_back(DroneCheckpoint{ 0, { 1, 1 }, { { 0, 1, 1, 5 }, { 1, 2, 1, 3 } } });
+    cp.visits = { { 1, 1, 0 }, { 2, 1, 1 } };
+    const auto path = tempPath("roundtrip.ckpt");
+    saveCheckpoint(path, cp);
+
+    const auto back = loadCheckpoint(path);
+    EXPECT_EQ(back.gridN, 7);
+    EXPECT_EQ(back.horizon, 2);
+    EXPECT_FALSE(back.allowStay);
+    EXPECT_EQ(back.step, 4);
+    EXPECT_EQ(back.score, 123);
+    EXPECT_EQ(back.stepDeadlineUs, 250);
+    EXPECT_EQ(back.mapHash, 0x0123456789abcdefull);
+    EXPECT_EQ(back.run, cp.run);
+    ASSERT_EQ(back.drones.size(), 1u);
+    ASSERT_EQ(back.drones[0].path.size(), 2u);
+    EXPECT_EQ(back.drones[0].path[1].x, 2);
+    EXPECT_EQ(back.drones[0].path[1].valueCollected, 3);
+    ASSERT_EQ(back.visits.size(), 2u);
+    EXPECT_EQ(back.visits[1].t, 1);
+    std::filesystem::remove(path);
+}
+
+TEST(CheckpointTest, RejectsTruncatedFile) {
+    const auto path = tempPath("truncated.ckpt");
+    Checkpoint cp;
+    cp.drones.push_back(DroneCheckpoint{ 0, { 0, 0 }, { { 0, 0, 0, 1 } } });
+    saveCheckpoint(path, cp);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+    EXPECT_THROW((void)loadCheckpoint(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(CheckpointTest, ResumeIsBitIdentical) {
+    const auto path = tempPath("resume.ckpt");
+    std::filesystem::remove(path);
+
+    const auto full = runHandler(400, {}, 0, {});
+
+    // "Killed" after step 237: the last checkpoint on disk is step 200.
+    (void)runHandler(238, path, 50, {});
+    ASSERT_EQ(loadCheckpoint(path).step, 200);
+    EXPECT_EQ(runHandler(400, {}, 0, path), full);
+
+    // Resuming can itself checkpoint, and be resumed again.
+    (void)runHandler(320, path, 30, path);
+    ASSERT_EQ(loadCheckpoint(path).step, 300);
+    EXPECT_EQ(runHandler(400, {}, 0, path), full);
+    std::filesystem::remove(path);
+}
+
+TEST(CheckpointTest, ResumeRefusesAnotherMapOrSettings) {
+    const auto path = tempPath("mismatch.ckpt");
+    std::filesystem::remove(path);
+    const RunIdentity identity{ "greedy", { { "greedy.values", "lazy" } }, 0.2 };
+    (void)runHandler(120, path, 50, {}, 3u, identity);
+    ASSERT_EQ(loadCheckpoint(path).step, 100);
+
+    // Same settings resume; a different map, rate or planner parameter does not.
+    EXPECT_NO_THROW((void)runHandler(150, {}, 0, path, 3u, identity));
+    EXPECT_THROW((void)runHandler(150, {}, 0, path, 4u, identity), std::runtime_error);
+    RunIdentity rate = identity;
+    rate.regrowthRate = 0.3;
+    EXPECT_THROW((void)runHandler(150, {}, 0, path, 3u, rate), std::runtime_error);
+    RunIdentity values = identity;
+    values.plannerParams["greedy.values"] = "eager";
+    EXPECT_THROW((void)runHandler(150, {}, 0, path, 3u, values), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(CheckpointTest, PlannerParamsKeepOnlyAlgoSections) {
+    const ParamSections params{ { "algo.greedy", { { "values", "eager" } } },
+                                { "loader.text", { { "x", "1" } } } };
+    EXPECT_EQ(plannerParams(params), (ParamBlock{ { "greedy.values", "eager" } }));
+}
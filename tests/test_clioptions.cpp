@@ -20,3 +20,91 @@ TEST(CLIOptionsParseTest, HelpReturnsFalseAndDoesNotThrow) {
 }
 
 
+
+TEST(CLIOptionsParseTest, AlgoLoaderAndParamBlocks) {
+    const char* argv[] = {"app", "--file", "g.txt", "--steps", "10", "--time_ms", "5",
+                          "--algo", "auto", "--loader", "text",
+                          "--param", "algo.greedy.depth=3"};
+    CLIOptions opt(13, const_cast<char**>(argv));
+    ASSERT_TRUE(opt.parseCLI());
+    EXPECT_EQ(opt.algoName(), "auto");
+    EXPECT_EQ(opt.loaderName(), "text");
+    ASSERT_EQ(opt.params().count("algo.greedy"), 1u);
+    EXPECT_EQ(opt.params().at("algo.greedy").at("depth"), "3");
+}
+
+TEST(CLIOptionsParseTest, MalformedParamThrows) {
+    const char* argv[] = {"app", "--file", "g.txt", "--steps", "10", "--time_ms", "5",
+                          "--param", "depth=3"};
+    CLIOptions opt(9, const_cast<char**>(argv));
+    EXPECT_THROW((void)opt.parseCLI(), std::runtime_error);
+}
+
+TEST(CLIOptionsParseTest, ReportsAllProblemsTogether) {
+    const char* argv[] = {"app", "--file", "g.txt", "--steps", "0", "--time_ms", "5",
+                          "--horizon", "3", "--workers", "-1"};
+    CLIOptions opt(11, const_cast<char**>(argv));
+    try {
+        (void)opt.parseCLI();
+        FAIL() << "expected an error";
+    } catch (const std::runtime_error& e) {
+        const std::string msg = e.what();
+        EXPECT_NE(msg.find("--steps must be a positive integer"), std::string::npos) << msg;
+        EXPECT_NE(msg.find("--horizon must be 1 or 2"), std::string::npos) << msg;
+        EXPECT_NE(msg.find("--workers must be >= 0"), std::string::npos) << msg;
+    }
+}
+
+TEST(CLIOptionsParseTest, ReportsEveryMalformedValue) {
+    const char* argv[] = {"app", "--file", "g.txt", "--steps", "abc", "--time_ms", "5",
+                          "--horizon", "x", "--layout", "diagonal"};
+    CLIOptions opt(11, const_cast<char**>(argv));
+    try {
+        (void)opt.parseCLI();
+        FAIL() << "expected an error";
+    } catch (const std::runtime_error& e) {
+        const std::string msg = e.what();
+        EXPECT_NE(msg.find("--steps expects an integer, got 'abc'"), std::string::npos) << msg;
+        EXPECT_NE(msg.find("--horizon expects an integer, got 'x'"), std::string::npos) << msg;
+        EXPECT_NE(msg.find("--layout expects rowmajor or tiled, got 'diagonal'"), std::string::npos) << msg;
+        EXPECT_EQ(msg.find("--steps must be"), std::string::npos) << msg;   // reported once
+    }
+}
+
+TEST(CLIOptionsParseTest, RunConfigCarriesValidatedSettings) {
+    const char* argv[] = {"app", "--file", "g.txt", "--steps", "10", "--time_ms", "5",
+                          "--start", "1,2", "--start", "3,4", "--regrowth_rate", "0.5"};
+    CLIOptions opt(13, const_cast<char**>(argv));
+    ASSERT_TRUE(opt.parseCLI());
+    const RunConfig& run = opt.runConfig();
+    EXPECT_EQ(run.algoConfig().totalSteps, 10);
+    EXPECT_EQ(run.starts().size(), 2u);
+    EXPECT_DOUBLE_EQ(run.loader().regrowthRate, 0.5);
+    EXPECT_EQ(run.loader().file, "g.txt");
+}
+
+TEST(CLIOptionsParseTest, RejectsUnknownParamSections) {
+    const char* argv[] = {"app", "--file", "g.txt", "--steps", "10", "--time_ms", "5",
+                          "--param", "algo.gredy.values=lazy", "--param", "loader.text.x=1"};
+    CLIOptions opt(11, const_cast<char**>(argv));
+    try {
+        (void)opt.parseCLI();
+        FAIL() << "expected an error";
+    } catch (const std::runtime_error& e) {
+        const std::string msg = e.what();
+        EXPECT_NE(msg.find("[algo.gredy]"), std::string::npos) << msg;
+        EXPECT_EQ(msg.find("[loader.text]"), std::string::npos) << msg;
+    }
+}
+
+TEST(CLIOptionsParseTest, CheckpointPathNeedsAnInterval) {
+    const char* argv[] = {"app", "--file", "g.txt", "--steps", "10", "--time_ms", "5",
+                          "--checkpoint", "run.ckpt"};
+    CLIOptions opt(9, const_cast<char**>(argv));
+    try {
+        (void)opt.parseCLI();
+        FAIL() << "expected an error";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("--checkpoint requires --checkpoint_every"), std::string::npos) << e.what();
+    }
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "RunConfig.h"
+
+namespace {
+
+RunConfig defaults() {
+    RunConfigDraft d;
+    d.cfg    = GridAlgoConfig{ 100, 50, 2, true };
+    d.starts = { { 1, 2 } };
+    std::vector<ConfigIssue> issues;
+    return *d.build(issues);
+}
+
+} // namespace
+
+TEST(ConfigValueTest, ParsesOnlyWholeValues) {
+    int i = 7;
+    EXPECT_TRUE(config::parseInt("+42", i));
+    EXPECT_EQ(i, 42);
+    EXPECT_FALSE(config::parseInt("12abc", i));
+    EXPECT_FALSE(config::parseInt("", i));
+    EXPECT_FALSE(config::parseInt("99999999999", i));
+    EXPECT_FALSE(config::parseInt("+-5", i));
+    EXPECT_EQ(i, 42);   // untouched on failure
+
+    double d = 0.0;
+    EXPECT_TRUE(config::parseDouble("0.25", d));
+    EXPECT_DOUBLE_EQ(d, 0.25);
+    EXPECT_FALSE(config::parseDouble("0.25x", d));
+    EXPECT_FALSE(config::parseDouble("+-0.5", d));
+
+    bool b = false;
+    EXPECT_TRUE(config::parseBool("Yes", b));
+    EXPECT_TRUE(b);
+    EXPECT_TRUE(config::parseBool("off", b));
+    EXPECT_FALSE(b);
+    EXPECT_FALSE(config::parseBool("maybe", b));
+
+    Position p{};
+    EXPECT_TRUE(config::parsePosition("3, 4", p));
+    EXPECT_EQ(p.x, 3);
+    EXPECT_EQ(p.y, 4);
+    EXPECT_FALSE(config::parsePosition("3", p));
+}
+
+TEST(ScenarioFileTest, LinesAndBlocksOverrideDefaults) {
+    const std::string text =
+        "# sweep\n"
+        "steps=10 horizon=1\n"
+        "start=5,5 start=6,6 allow_stay=no\n"
+        "\n"
+        "[[scenario]]\n"
+        "algo = greedy   # trailing comment\n"
+        "time_ms = 7\n"
+        "[[scenario]]\n";
+    std::vector<ConfigIssue> issues;
+    const auto scenarios = parseScenarios(text, defaults(), issues);
+    ASSERT_TRUE(issues.empty()) << formatIssues(issues, "text");
+    ASSERT_EQ(scenarios.size(), 4u);
+
+    EXPECT_EQ(scenarios[0].algoConfig().totalSteps, 10);
+    EXPECT_EQ(scenarios[0].algoConfig().horizon, 1);
+    EXPECT_EQ(scenarios[0].starts().size(), 1u);
+
+    ASSERT_EQ(scenarios[1].starts().size(), 2u);   // start= replaces the defaults
+    EXPECT_EQ(scenarios[1].starts()[1].x, 6);
+    EXPECT_FALSE(scenarios[1].algoConfig().allowStay);
+
+    EXPECT_EQ(scenarios[2].algoConfig().timeBudgetMs, 7);
+    EXPECT_EQ(scenarios[2].algoConfig().totalSteps, 100);
+    EXPECT_EQ(scenarios[3].algoConfig().timeBudgetMs, 50);
+}
+
+TEST(ScenarioFileTest, ReportsEveryProblemInOnePass) {
+    const std::string text =
+        "steps=abc\n"
+        "horizon=3\n"
+        "steps=5\n"
+        "[[scenario]]\n"
+        "colour = blue\n"
+        "start = 1\n"
+        "[[scenario]]\n"
+        "time_ms = 0\n"
+        "steps = -1\n";
+    std::vector<ConfigIssue> issues;
+    const auto scenarios = parseScenarios(text, defaults(), issues);
+    ASSERT_EQ(scenarios.size(), 1u);
+    EXPECT_EQ(scenarios[0].algoConfig().totalSteps, 5);
+
+    std::vector<int> lines;
+    for (const auto& i : issues) lines.push_back(i.line);
+    EXPECT_EQ(lines, (std::vector<int>{ 1, 2, 5, 6, 7, 7 }));
+    const auto report = formatIssues(issues, "s.txt");
+    EXPECT_NE(report.find("s.txt:2: horizon must be 1 or 2"), std::string::npos) << report;
+    EXPECT_NE(report.find("s.txt:5: unknown key 'colour'"), std::string::npos) << report;
+}
+
+TEST(ScenarioFileTest, ParsesLargeSweeps) {
+    std::string text;
+    for (int i = 0; i < 20'000; ++i) {
+        text += "steps=" + std::to_string(100 + i) + " horizon=" + std::to_string(1 + i % 2)
+              + " start=" + std::to_string(i % 97) + "," + std::to_string(i % 89) + "\n";
+    }
+    std::vector<ConfigIssue> issues;
+    const auto scenarios = parseScenarios(text, defaults(), issues);
+    ASSERT_TRUE(issues.empty());
+    ASSERT_EQ(scenarios.size(), 20'000u);
+    EXPECT_EQ(scenarios.back().algoConfig().totalSteps, 100 + 19'999);
+    EXPECT_EQ(scenarios.back().starts()[0].y, 19'999 % 89);
+}
@@ -0,0 +1,178 @@
+// Differential tests: every registered planner, in every grid storage
+// layout, against the generic reference kernel on random seeded maps.
+// DIFF_SEEDS=<n> changes the number of maps (default 2000); a failure
+// names the seed and candidate so it can be replayed alone.
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+#include "GridAlgo.h"
+#include "PlannerRegistry.h"
+#include "ScoreValidator.h"
+#include "struct/Drone.h"
+#include "struct/Grid.h"
+#include "struct/GridAlgoConfig.h"
+#include "struct/Result.h"
+
+namespace {
+
+struct Candidate {
+    std::string       name;
+    std::string       planner;
+    ParamSections     params;
+    GridStorageConfig storage;
+};
+
+std::vector<Candidate> candidates() {
+    const std::pair<const char*, GridStorageConfig> storages[] = {
+        { "rowmajor",        GridStorageConfig{ false, GridLayout::RowMajor } },
+        { "rowmajor+padded", GridStorageConfig{ true,  GridLayout::RowMajor } },
+        { "tiled",           GridStorageConfig{ false, GridLayout::Tiled } },
+        { "tiled+padded",    GridStorageConfig{ true,  GridLayout::Tiled } },
+    };
+    std::vector<Candidate> out;
+    for (const auto& entry : PlannerRegistry::instance().entries()) {
+        for (const auto& [layout, storage] : storages) {
+            out.push_back(Candidate{ entry.name + "/" + layout, entry.name, {}, storage });
+        }
+    }
+    // Greedy's value modes are picked by job shape; force each one.
+    for (const char* values : { "lazy", "eager" }) {
+        for (const auto& [layout, storage] : storages) {
+            out.push_back(Candidate{ std::string("greedy/values=") + values + "/" + layout, "greedy",
+                                     ParamSections{ { "algo.greedy", { { "values", values } } } }, storage });
+        }
+    }
+    return out;
+}
+
+int seedCount() {
+    const char* env = std::getenv("DIFF_SEEDS");
+    return env ? std::max(1, std::atoi(env)) : 2000;
+}
+
+// A small random job: maps from 1x1 up, zero cells, crowded starts.
+struct Job {
+    int                   n;
+    std::vector<CellValue> base, inc;
+    std::vector<Position> starts;
+    GridAlgoConfig        cfg;
+
+    explicit Job(unsigned seed) {
+        std::mt19937 rng(seed);
+        auto uniform = [&rng](int lo, int hi) { return std::uniform_int_distribution<int>(lo, hi)(rng); };
+        n = uniform(1, 14);
+        const int maxBase = uniform(0, 3) == 0 ? 3 : 60;
+        for (int k = 0; k < n * n; ++k) {
+            const int b = uniform(0, 4) == 0 ? 0 : uniform(0, maxBase);
+            base.push_back(b);
+            inc.push_back(uniform(0, std::max(1, b / 2)));
+        }
+        const int drones = uniform(1, 4);
+        for (int i = 0; i < drones; ++i) starts.push_back({ uniform(0, n - 1), uniform(0, n - 1) });
+        cfg = GridAlgoConfig{ uniform(1, 80), 1'000'000, uniform(1, 2), uniform(0, 1) == 1 };
+    }
+
+    [[nodiscard]] Grid grid(const GridStorageConfig& storage) const {
+        Grid g;
+        g.initialize(n, storage);
+        for (int y = 0; y < n; ++y) {
+            for (int x = 0; x < n; ++x) {
+                g.setCell(x, y, base[Grid::idx(x, y, n)], inc[Grid::idx(x, y, n)]);
+            }
+        }
+        return g;
+    }
+
+    RunResult run(IGridAlgo& algo, Grid& g) const {
+        std::vector<Drone> drones;
+        for (std::size_t i = 0; i < starts.size(); ++i) {
+            drones.emplace_back(static_cast<int>(i), starts[i]);
+            drones.back().resetToStart(cfg.totalSteps);
+        }
+        return algo.run(g, std::span<Drone>(drones), cfg);
+    }
+};
+
+// Empty when equal, else where they first differ
+std::string firstDifference(const RunResult& a, const RunResult& b) {
+    if (a.paths.size() != b.paths.size()) return "drone count";
+    for (std::size_t d = 0; d < a.paths.size(); ++d) {
+        if (a.paths[d].path.size() != b.paths[d].path.size()) return "drone " + std::to_string(d) + " path length";
+        for (std::size_t s = 0; s < a.paths[d].path.size(); ++s) {
+            const auto& l = a.paths[d].path[s];
+            const auto& r = b.paths[d].path[s];
+            if (l.x != r.x || l.y != r.y || l.valueCollected != r.valueCollected) {
+                return "drone " + std::to_string(d) + " step " + std::to_string(s);
+            }
+        }
+    }
+    if (a.totalScore != b.totalScore) return "total score";
+    return {};
+}
+
+} // namespace
+
+TEST(DifferentialTest, PlannersAndLayoutsMatchReference) {
+    const auto all = candidates();
+    std::vector<std::unique_ptr<IGridAlgo>> algos;
+    for (const auto& c : all) algos.push_back(PlannerRegistry::instance().create(c.planner, c.params));
+    GridAlgo reference(GridAlgo::Kernel::Generic);
+
+    const int seeds = seedCount();
+    for (int seed = 1; seed <= seeds; ++seed) {
+        const Job job(static_cast<unsigned>(seed));
+        Grid refGrid = job.grid({});
+        const RunResult expected = job.run(reference, refGrid);
+        const ScoreCheck check = validateRun(refGrid, expected, job.cfg.allowStay);
+        ASSERT_TRUE(check.ok) << "seed " << seed << ": reference fails validation: " << check.error;
+
+        for (std::size_t i = 0; i < all.size(); ++i) {
+            Grid g = job.grid(all[i].storage);
+            const std::string diff = firstDifference(expected, job.run(*algos[i], g));
+            ASSERT_TRUE(diff.empty()) << all[i].name << " differs from the reference at " << diff
+                                      << " (seed " << seed << ")";
+        }
+    }
+}
+
+TEST(ScoreValidatorTest, RejectsTamperedRuns) {
+    Job job(7u);
+    job.cfg.totalSteps = 20;
+    Grid g = job.grid({});
+    GridAlgo algo;
+    const RunResult good = job.run(algo, g);
+    ASSERT_TRUE(validateRun(g, good, job.cfg.allowStay).ok);
+
+    RunResult value = good;
+    value.paths[0].path[1].valueCollected += 1;
+    value.totalScore += 1;
+    EXPECT_NE(validateRun(g, value, job.cfg.allowStay).error.find("regrowth model"), std::string::npos);
+
+    RunResult score = good;
+    score.totalScore += 1;
+    EXPECT_NE(validateRun(g, score, job.cfg.allowStay).error.find("reported score"), std::string::npos);
+
+    RunResult jump = good;
+    jump.paths[0].path[1].x = jump.paths[0].path[0].x + 2;   // or off the map
+    EXPECT_FALSE(validateRun(g, jump, job.cfg.allowStay).ok);
+
+    RunResult gap = good;
+    gap.paths[0].path[1].timeStep = 5;
+    EXPECT_NE(validateRun(g, gap, job.cfg.allowStay).error.find("time"), std::string::npos);
+}
+
+TEST(ScoreValidatorTest, SameCellTwiceInOneStepYieldsZero) {
+    Grid g;
+    g.initialize(3, 10, 5);
+    RunResult r;
+    r.paths = { DronePath{ 0, { Step{ 0, 1, 1, 10 }, Step{ 1, 0, 0, 10 } } },
+                DronePath{ 1, { Step{ 0, 1, 1, 0 },  Step{ 1, 0, 0, 0 } } } };
+    r.totalScore = 20;
+    EXPECT_TRUE(validateRun(g, r, true).ok) << validateRun(g, r, true).error;
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "GridAlgo.h"
+#include "struct/Grid.h"
+#include "struct/Drone.h"
+#include "struct/GridAlgoConfig.h"
+#include "struct/Result.h"
+#include "test_support.h"
+
+namespace {
+
+// Base 0-9, regrowing at a third of it per step
+Grid makeGrid(int n, unsigned seed, const GridStorageConfig& storage) {
+    return test_support::makeGrid(n, seed, storage, 9, 3);
+}
+
+RunResult runOn(Grid& g, const std::vector<Position>& starts, const GridAlgoConfig& cfg,
+                GridAlgo::Kernel kernel, GridAlgo::Values values = GridAlgo::Values::Auto) {
+    GridAlgo algo(kernel, values);
+    return test_support::runSwarm(algo, g, starts, cfg);
+}
+
+void expectSamePaths(const RunResult& a, const RunResult& b) {
+    ASSERT_EQ(a.totalScore, b.totalScore);
+    ASSERT_EQ(a.paths.size(), b.paths.size());
+    for (std::size_t d = 0; d < a.paths.size(); ++d) {
+        ASSERT_EQ(a.paths[d].path.size(), b.paths[d].path.size());
+        for (std::size_t s = 0; s < a.paths[d].path.size(); ++s) {
+            const auto& l = a.paths[d].path[s];
+            const auto& r = b.paths[d].path[s];
+            ASSERT_EQ(l.x, r.x) << "drone " << d << " step " << s;
+            ASSERT_EQ(l.y, r.y) << "drone " << d << " step " << s;
+            ASSERT_EQ(l.valueCollected, r.valueCollected) << "drone " << d << " step " << s;
+        }
+    }
+}
+
+} // namespace
+
+TEST(GridStorageTest, SentinelRingSurroundsMap) {
+    Grid g;
+    g.initialize(3, GridStorageConfig{ true }, 7, 1);
+    EXPECT_EQ(g.stride, 3 + 2 * Grid::kPad);
+    EXPECT_EQ(g.valueAt(0, 0, 0), 7);
+    EXPECT_EQ(g.valueAtIndex(g.idx(0, 0) + g.offset(-1, 0), 0), Grid::kSentinel);
+    EXPECT_EQ(g.valueAtIndex(g.idx(2, 2) + g.offset(2, 2), 0), Grid::kSentinel);
+}
+
+TEST(GridStorageTest, TiledIndicesAreABijection) {
+    for (int n : { 1, 3, 4, 7, 9 }) {
+        for (bool padded : { false, true }) {
+            Grid g;
+            g.initialize(n, GridStorageConfig{ padded, GridLayout::Tiled });
+            std::vector<int> seen(g.base.size(), 0);
+            for (int y = -g.pad; y < n + g.pad; ++y) {
+                for (int x = -g.pad; x < n + g.pad; ++x) {
+                    ASSERT_LT(g.idx(x, y), seen.size());
+                    EXPECT_EQ(++seen[g.idx(x, y)], 1) << "n " << n << " (" << x << "," << y << ")";
+                }
+            }
+        }
+    }
+}
+
+TEST(GridStorageTest, NeighbourhoodMatchesIdx) {
+    for (auto layout : { GridLayout::RowMajor, GridLayout::Tiled }) {
+        for (bool padded : { false, true }) {
+            Grid g;
+            g.initialize(6, GridStorageConfig{ padded, layout });
+            std::array<std::size_t, 25> cells{};
+            for (int y = 0; y < 6; ++y) {
+                for (int x = 0; x < 6; ++x) {
+                    g.neighbourhood<2>(x, y, cells);
+                    for (int r = 0; r < 5; ++r) {
+                        for (int c = 0; c < 5; ++c) {
+                            const int cx = x - 2 + c, cy = y - 2 + r;
+                            const bool stored = cx >= -g.pad && cy >= -g.pad &&
+                                                cx < 6 + g.pad && cy < 6 + g.pad;
+                            EXPECT_EQ(cells[r * 5 + c], stored ? g.idx(cx, cy) : Grid::kNoCell);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(GridStorageTest, LayoutsMatchReference) {
+    for (unsigned seed = 1; seed <= 200; ++seed) {
+        std::mt19937 rng(seed * 7919u);
+        const int n = 1 + static_cast<int>(rng() % 12);
+        std::uniform_int_distribution<int> coord(0, n - 1);
+        std::vector<Position> starts;
+        const int droneCount = 1 + static_cast<int>(rng() % 3);
+        for (int i = 0; i < droneCount; ++i) starts.push_back({ coord(rng), coord(rng) });
+
+        GridAlgoConfig cfg;
+        cfg.totalSteps   = 60;
+        cfg.timeBudgetMs = 1'000'000;
+        cfg.horizon      = 1 + static_cast<int>(seed % 2);
+        cfg.allowStay    = (seed / 2) % 2 == 0;
+
+        Grid reference = makeGrid(n, seed, {});
+        const auto expected = runOn(reference, starts, cfg, GridAlgo::Kernel::Generic);
+
+        SCOPED_TRACE("seed " + std::to_string(seed) + " n " + std::to_string(n));
+        for (auto layout : { GridLayout::RowMajor, GridLayout::Tiled }) {
+            for (bool padded : { false, true }) {
+                for (auto values : { GridAlgo::Values::Lazy, GridAlgo::Values::Eager }) {
+                    Grid g = makeGrid(n, seed, GridStorageConfig{ padded, layout });
+                    expectSamePaths(expected, runOn(g, starts, cfg, GridAlgo::Kernel::Specialized, values));
+                }
+                Grid g = makeGrid(n, seed, GridStorageConfig{ padded, layout });
+                expectSamePaths(expected, runOn(g, starts, cfg, GridAlgo::Kernel::Generic));
+            }
+        }
+    }
+}
+
+TEST(GridStorageTest, EagerValuesMatchLazyInDenseSwarms) {
+    for (unsigned seed = 1; seed <= 10; ++seed) {
+        std::mt19937 rng(seed);
+        const int n = 20 + static_cast<int>(rng() % 30);
+        std::uniform_int_distribution<int> coord(0, n - 1);
+        std::vector<Position> starts;
+        for (int i = 0; i < 24; ++i) starts.push_back({ coord(rng), coord(rng) });
+
+        GridAlgoConfig cfg;
+        cfg.totalSteps   = 400;
+        cfg.timeBudgetMs = 1'000'000;
+        cfg.horizon      = 2;
+        cfg.allowStay    = seed % 2 == 0;
+        const GridStorageConfig storage{ seed % 3 == 0, seed % 4 == 0 ? GridLayout::Tiled : GridLayout::RowMajor };
+
+        SCOPED_TRACE("seed " + std::to_string(seed));
+        Grid lazyGrid = makeGrid(n, seed, storage);
+        const auto expected = runOn(lazyGrid, starts, cfg, GridAlgo::Kernel::Specialized, GridAlgo::Values::Lazy);
+
+        Grid eagerGrid = makeGrid(n, seed, storage);
+        expectSamePaths(expected, runOn(eagerGrid, starts, cfg, GridAlgo::Kernel::Specialized, GridAlgo::Values::Eager));
+        // The eager run leaves the same visit times behind.
+        EXPECT_TRUE(std::equal(lazyGrid.lastVisitTime.begin(), lazyGrid.lastVisitTime.end(),
+                               eagerGrid.lastVisitTime.begin()));
+
+        // Eager state rebuilt mid-run from visit times (as after --resume)
+        Grid split = makeGrid(n, seed, storage);
+        std::vector<Drone> drones;
+        for (std::size_t i = 0; i < starts.size(); ++i) {
+            drones.emplace_back(static_cast<int>(i), starts[i]);
+            drones.back().resetToStart(cfg.totalSteps);
+        }
+        GridAlgo algo(GridAlgo::Kernel::Specialized, GridAlgo::Values::Eager);
+        GridAlgoConfig first = cfg;
+        first.totalSteps = 150;
+        const auto head = algo.run(split, std::span<Drone>(drones), first);
+        GridAlgoConfig rest = cfg;
+        rest.firstStep    = first.totalSteps;
+        rest.initialScore = head.totalScore;
+        expectSamePaths(expected, algo.run(split, std::span<Drone>(drones), rest));
+    }
+}
+
+TEST(GridStorageTest, HugePageRequestsFallBackAndFill) {
+    for (auto policy : { HugePages::Off, HugePages::Transparent, HugePages::Explicit }) {
+        GridArray<int> a;
+        a.allocate(1 << 20, policy);
+        ASSERT_EQ(a.size(), std::size_t{1} << 20);
+        EXPECT_NE(a.backing(), GridBacking::None);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(a.data()) % GridArray<int>::kAlign, 0u);
+        a.fill(7);
+        EXPECT_TRUE(std::all_of(a.begin(), a.end(), [](int v) { return v == 7; }));
+    }
+}
+
+TEST(GridStorageTest, FirstTouchSplitsEveryArrayAlike) {
+    const FirstTouch touch(100'000, 3);
+    ASSERT_EQ(touch.parts(), 3u);
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < touch.parts(); ++i) {
+        const auto [begin, end] = touch.range(i);
+        EXPECT_EQ(begin, next);
+        EXPECT_EQ(begin % FirstTouch::kAlignCells, 0u);
+        next = end;
+    }
+    EXPECT_EQ(next, 100'000u);
+    EXPECT_EQ(FirstTouch(1000, 8).parts(), 1u);   // below one aligned part
+
+    Grid g;
+    g.initialize(400, GridStorageConfig{ true, GridLayout::Tiled, HugePages::Off, 3 });
+    EXPECT_EQ(g.firstTouch().parts(), 3u);
+    EXPECT_TRUE(std::all_of(g.lastVisitTime.begin(), g.lastVisitTime.end(), [](int v) { return v == -1; }));
+    EXPECT_EQ(g.valueAt(0, 0, 0), 0);
+    EXPECT_EQ(g.base[0], Grid::kSentinel);
+}
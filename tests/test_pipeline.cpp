@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include "GridAlgo.h"
+#include "GridFileLoader.h"
+#include "GridHandler.h"
+
+namespace {
+
+std::filesystem::path writeGridFile(const std::string& name, int n, unsigned seed, bool corruptLastRow) {
+    const auto path = std::filesystem::temp_directory_path() / ("drone_swarm_" + name);
+    std::mt19937 rng(seed);
+    std::ofstream out(path);
+    out << n << "\n";
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            if (corruptLastRow && y == n - 1 && x == n / 2) out << "x ";
+            else out << rng() % 50 << ' ';
+        }
+        out << "\n";
+    }
+    return path;
+}
+
+std::string stripTiming(std::string json) {
+    const auto at = json.find("\"time_elapsed_ms\"");
+    return at == std::string::npos ? json : json.erase(at, json.find('\n', at) - at);
+}
+
+std::string runHandler(const std::filesystem::path& file, const GridStorageConfig& storage,
+                       bool pipelined) {
+    GridAlgoConfig cfg{ 3000, 1'000'000, 2, true };
+    GridHandler handler(std::make_unique<GridFileLoader>(file, 0.1, storage), std::make_unique<GridAlgo>(),
+                        { { 0, 0 }, { 150, 199 }, { 99, 100 } }, cfg);
+    if (pipelined) handler.enablePipelining();
+    handler.loadGrid();
+    testing::internal::CaptureStdout();
+    try {
+        handler.run();
+    } catch (...) {
+        testing::internal::GetCapturedStdout();
+        throw;
+    }
+    return stripTiming(testing::internal::GetCapturedStdout());
+}
+
+} // namespace
+
+TEST(PipelineTest, OutputMatchesSequential) {
+    const auto file = writeGridFile("pipeline.txt", 200, 11u, false);
+    for (const GridStorageConfig storage : { GridStorageConfig{},
+                                             GridStorageConfig{ true, GridLayout::Tiled } }) {
+        const auto sequential = runHandler(file, storage, false);
+        const auto pipelined  = runHandler(file, storage, true);
+        EXPECT_EQ(sequential, pipelined);
+        EXPECT_NE(sequential.find("\"steps\": 3000"), std::string::npos);
+    }
+    std::filesystem::remove(file);
+}
+
+TEST(PipelineTest, MalformedRowFailsTheRun) {
+    const auto file = writeGridFile("pipeline_bad.txt", 200, 12u, true);
+    EXPECT_THROW(runHandler(file, {}, true), std::runtime_error);
+    EXPECT_THROW(runHandler(file, {}, false), std::runtime_error);
+    std::filesystem::remove(file);
+}
+
+TEST(PipelineTest, PlusSignNeedsADigit) {
+    const auto file = std::filesystem::temp_directory_path() / "drone_swarm_signs.txt";
+    for (const char* token : { "+-5", "++5" }) {
+        std::ofstream(file) << "2\n1 " << token << "\n2 3\n";
+        EXPECT_THROW((void)GridFileLoader(file, 0.1, {}).loadGrid(), std::runtime_error) << token;
+    }
+    std::ofstream(file) << "2\n1 +5\n2 3\n";
+    EXPECT_EQ(GridFileLoader(file, 0.1, {}).loadGrid()->valueAt(1, 0, 0), 5);
+    std::filesystem::remove(file);
+}
@@ -0,0 +1,168 @@
+// Golden scores and path fingerprints for data/20.txt and data/100.txt.
+// Every registered planner must reproduce them exactly. After an
+// intentional behaviour change, regenerate with
+//   UPDATE_GOLDEN=1 ./regression_tests --gtest_filter='GoldenTest.*'
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "GridFileLoader.h"
+#include "PlannerRegistry.h"
+#include "ScoreValidator.h"
+#include "struct/Drone.h"
+#include "struct/Grid.h"
+#include "struct/GridAlgoConfig.h"
+#include "struct/Result.h"
+
+namespace {
+
+const std::filesystem::path kGoldenFile = std::filesystem::path(GOLDEN_DIR) / "planner_runs.tsv";
+
+struct Case {
+    std::string file;
+    int         steps;
+    int         horizon;
+    bool        allowStay;
+    double      regrowth;
+    int         drones;
+
+    // First columns of the golden file
+    [[nodiscard]] std::string key() const {
+        std::ostringstream ss;
+        ss << file << '\t' << steps << '\t' << horizon << '\t' << allowStay << '\t'
+           << regrowth << '\t' << drones;
+        return ss.str();
+    }
+};
+
+struct Golden {
+    long long     score = 0;
+    std::uint64_t fingerprint = 0;
+};
+
+std::vector<Case> cases() {
+    // 20.txt bases are 0, 3 or 5, so 0.05 and 0.2 both give inc = 1 there
+    // and 0.5 lets a drone alternate between two 5s as at 1.0. Its rates give
+    // incs (0, 0), (1, 2) and (3, 5) for bases 3 and 5.
+    struct MapRuns {
+        const char*           file;
+        int                   steps;
+        std::array<double, 3> regrowth;
+    };
+    const MapRuns maps[] = { { "20.txt", 400, { 0.0, 0.3, 1.0 } }, { "100.txt", 2000, { 0.05, 0.2, 1.0 } } };
+
+    std::vector<Case> out;
+    for (const auto& [file, steps, rates] : maps) {
+        for (int horizon : { 1, 2 }) {
+            for (bool stay : { true, false }) {
+                for (double regrowth : rates) {
+                    for (int drones : { 1, 3 }) {
+                        out.push_back(Case{ file, steps, horizon, stay, regrowth, drones });
+                    }
+                }
+            }
+        }
+    }
+    return out;
+}
+
+// FNV-1a over every step of every path
+std::uint64_t fingerprint(const RunResult& r) {
+    std::uint64_t h = 1469598103934665603ull;
+    auto mix = [&h](long long v) {
+        for (int i = 0; i < 8; ++i) {
+            h ^= static_cast<std::uint64_t>(v >> (8 * i)) & 0xffu;
+            h *= 1099511628211ull;
+        }
+    };
+    for (const auto& p : r.paths) {
+        mix(p.droneId);
+        for (const auto& s : p.path) {
+            mix(s.timeStep);
+            mix(s.x);
+            mix(s.y);
+            mix(s.valueCollected);
+        }
+    }
+    return h;
+}
+
+struct PlannedCase {
+    std::unique_ptr<Grid> grid;   // kept for validation
+    RunResult             result;
+};
+
+PlannedCase runCase(const std::string& planner, const Case& c) {
+    PlannedCase run;
+    run.grid = GridFileLoader(std::filesystem::path(DATA_DIR) / c.file, c.regrowth).loadGrid();
+
+    const int n = run.grid->N;
+    const std::vector<Position> starts = { { n / 2, n / 2 }, { 0, 0 }, { n - 1, n / 3 } };
+    std::vector<Drone> drones;
+    for (int i = 0; i < c.drones; ++i) {
+        drones.emplace_back(i, starts[static_cast<std::size_t>(i)]);
+        drones.back().resetToStart(c.steps);
+    }
+    const GridAlgoConfig cfg{ c.steps, 1'000'000, c.horizon, c.allowStay };
+    auto algo = PlannerRegistry::instance().create(planner, {});
+    run.result = algo->run(*run.grid, std::span<Drone>(drones), cfg);
+    return run;
+}
+
+std::map<std::string, Golden> readGolden() {
+    std::map<std::string, Golden> out;
+    std::ifstream in(kGoldenFile);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        // key columns, then score and fingerprint
+        const auto fp    = line.rfind('\t');
+        const auto score = line.rfind('\t', fp - 1);
+        Golden g;
+        g.score       = std::stoll(line.substr(score + 1, fp - score - 1));
+        g.fingerprint = std::stoull(line.substr(fp + 1), nullptr, 16);
+        out.emplace(line.substr(0, score), g);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(GoldenTest, PlannersReproduceGoldenRuns) {
+    if (std::getenv("UPDATE_GOLDEN")) {
+        std::ofstream out(kGoldenFile);
+        out << "# file\tsteps\thorizon\tallow_stay\tregrowth\tdrones\tscore\tpath_fnv1a\n";
+        for (const auto& c : cases()) {
+            const RunResult r = runCase("greedy-generic", c).result;
+            out << c.key() << '\t' << r.totalScore << '\t' << std::hex << fingerprint(r) << std::dec << '\n';
+        }
+        ASSERT_TRUE(out.good()) << "cannot write " << kGoldenFile;
+        GTEST_SKIP() << "regenerated " << kGoldenFile;
+    }
+
+    const auto golden = readGolden();
+    ASSERT_FALSE(golden.empty()) << "missing " << kGoldenFile << "; run with UPDATE_GOLDEN=1";
+    for (const auto& entry : PlannerRegistry::instance().entries()) {
+        for (const auto& c : cases()) {
+            SCOPED_TRACE(entry.name + " " + c.key());
+            const auto it = golden.find(c.key());
+            ASSERT_NE(it, golden.end()) << "no golden entry; run with UPDATE_GOLDEN=1";
+
+            const PlannedCase run = runCase(entry.name, c);
+            EXPECT_EQ(run.result.totalScore, it->second.score);
+            EXPECT_EQ(fingerprint(run.result), it->second.fingerprint);
+
+            const ScoreCheck check = validateRun(*run.grid, run.result, c.allowStay);
+            EXPECT_TRUE(check.ok) << check.error;
+        }
+    }
+}
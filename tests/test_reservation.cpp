@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "GridAlgo.h"
+#include "PlannerRegistry.h"
+#include "ReservationTable.h"
+#include "ScoreValidator.h"
+#include "struct/Grid.h"
+#include "struct/GridAlgoConfig.h"
+#include "struct/Result.h"
+#include "test_support.h"
+
+using namespace test_support;
+
+TEST(ReservationTableTest, ClaimsHoldUntilTheirStep) {
+    ReservationTable table(16);
+    table.claim(3, 10, /*owner=*/1);
+    EXPECT_TRUE(table.claimedByOther(3, 10, 0));
+    EXPECT_TRUE(table.claimedByOther(3, 9, 0));
+    EXPECT_FALSE(table.claimedByOther(3, 11, 0));   // expired
+    EXPECT_FALSE(table.claimedByOther(3, 10, 1));   // own claim
+    EXPECT_FALSE(table.claimedByOther(4, 1, 0));    // never claimed
+
+    table.claim(3, 10, 2);                           // same step: first claim stands
+    EXPECT_FALSE(table.claimedByOther(3, 10, 1));
+    table.claim(3, 12, 2);                           // later step replaces it
+    EXPECT_TRUE(table.claimedByOther(3, 12, 1));
+    EXPECT_FALSE(table.claimedByOther(3, 12, 2));
+}
+
+TEST(ReservationTableTest, ConcurrentClaimsKeepTheLatestStep) {
+    constexpr int kThreads = 4, kCells = 64, kSteps = 2000;
+    ReservationTable table(kCells);
+    std::vector<std::thread> threads;
+    for (int id = 0; id < kThreads; ++id) {
+        threads.emplace_back([&table, id] {
+            for (int t = 1; t <= kSteps; ++t) {
+                for (std::size_t k = 0; k < kCells; ++k) table.claim(k, t * kThreads + id, id);
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    // The last claim on every cell is thread kThreads-1's final one.
+    for (std::size_t k = 0; k < kCells; ++k) {
+        EXPECT_TRUE(table.claimedByOther(k, kSteps * kThreads + kThreads - 1, 0));
+        EXPECT_FALSE(table.claimedByOther(k, kSteps * kThreads + kThreads - 1, kThreads - 1));
+    }
+}
+
+TEST(ReservationTest, CoordinatedRunsAreValidInEveryLayout) {
+    const GridStorageConfig storages[] = {
+        GridStorageConfig{ false, GridLayout::RowMajor }, GridStorageConfig{ true, GridLayout::RowMajor },
+        GridStorageConfig{ false, GridLayout::Tiled },    GridStorageConfig{ true, GridLayout::Tiled },
+    };
+    for (const bool stay : { true, false }) {
+        const GridAlgoConfig cfg{ 300, 1'000'000, 2, stay };
+        RunResult first;
+        for (std::size_t s = 0; s < std::size(storages); ++s) {
+            Grid g = makeGrid(30, 11, storages[s]);
+            GridAlgo algo(GridAlgo::Kernel::Specialized, GridAlgo::Values::Auto, 0.5);
+            const RunResult r = runSwarm(algo, g, clusterStarts(12, g.N), cfg);
+            const ScoreCheck check = validateRun(g, r, stay);
+            EXPECT_TRUE(check.ok) << check.error;
+            if (s == 0) first = r;
+            EXPECT_EQ(r.totalScore, first.totalScore) << "storage " << s;
+        }
+    }
+}
+
+TEST(ReservationTest, SecondDroneLeavesAClaimedHotspot) {
+    // Two neighbours two steps from a hotspot, with a smaller one the other
+    // way for drone 1. Both hotspots refill every step, so a drone that
+    // reaches one stays there; every other cell is worth 1 once.
+    auto run = [](double discount) {
+        Grid g;
+        g.initialize(7, CellValue{ 1 }, CellValue{ 0 });
+        g.setCell(3, 1, 100, 100);
+        g.setCell(6, 5, 50, 50);
+        GridAlgo algo(GridAlgo::Kernel::Specialized, GridAlgo::Values::Lazy, discount);
+        return runSwarm(algo, g, { { 3, 3 }, { 4, 3 } }, GridAlgoConfig{ 4, 1'000'000, 2, true });
+    };
+    const RunResult alone = run(0.0);
+    const RunResult coordinated = run(1.0);
+    ASSERT_EQ(alone.paths.size(), 2u);
+    ASSERT_EQ(coordinated.paths.size(), 2u);
+
+    // Drone 0 takes the hotspot on step 2 either way.
+    for (const auto* r : { &alone, &coordinated }) {
+        const auto& a = r->paths[0].path;
+        ASSERT_EQ(a.size(), 4u);
+        EXPECT_EQ(a[2].x, 3);
+        EXPECT_EQ(a[2].y, 1);
+        EXPECT_EQ(a[2].valueCollected, 100);
+    }
+    // Alone, drone 1 chases it too; with drone 0's claim in the table it
+    // heads for the other one instead.
+    const auto& chasing = alone.paths[1].path;
+    const auto& leaving = coordinated.paths[1].path;
+    ASSERT_EQ(leaving.size(), 4u);
+    EXPECT_EQ(chasing[1].y, 2);
+    EXPECT_EQ(leaving[1].x, 5);
+    EXPECT_EQ(leaving[1].y, 4);
+    EXPECT_EQ(leaving[2].x, 6);
+    EXPECT_EQ(leaving[2].y, 5);
+    EXPECT_EQ(leaving[2].valueCollected, 50);
+    EXPECT_GT(coordinated.totalScore, alone.totalScore);
+}
+
+TEST(ReservationTest, CostModelChargesForCoordination) {
+    const PlannerEntry* greedy = PlannerRegistry::instance().find("greedy");
+    ASSERT_NE(greedy, nullptr);
+    const ParamSections coordinated{ { "algo.greedy", { { "reservation_discount", "0.5" } } } };
+    const JobShape swarm{ 100, 32, 2000, 0, 2, true };
+    EXPECT_GT(PlannerRegistry::predictMs(*greedy, swarm, coordinated),
+              2.0 * PlannerRegistry::predictMs(*greedy, swarm));
+
+    // No coordination, so no extra cost, at horizon 1 or with one drone
+    JobShape single = swarm;
+    single.horizon = 1;
+    EXPECT_EQ(PlannerRegistry::predictMs(*greedy, single, coordinated), PlannerRegistry::predictMs(*greedy, single));
+    single = swarm;
+    single.drones = 1;
+    EXPECT_EQ(PlannerRegistry::predictMs(*greedy, single, coordinated), PlannerRegistry::predictMs(*greedy, single));
+}
+
+TEST(ReservationTest, ZeroDiscountPlansAlone) {
+    const GridAlgoConfig cfg{ 200, 1'000'000, 2, true };
+    Grid a = makeGrid(30, 4);
+    Grid b = makeGrid(30, 4);
+    GridAlgo plain;
+    auto viaRegistry = PlannerRegistry::instance().create(
+        "greedy", ParamSections{ { "algo.greedy", { { "reservation_discount", "0" } } } });
+    EXPECT_EQ(runSwarm(plain, a, clusterStarts(12, a.N), cfg).totalScore,
+              runSwarm(*viaRegistry, b, clusterStarts(12, b.N), cfg).totalScore);
+
+    EXPECT_THROW(PlannerRegistry::instance().create(
+                     "greedy", ParamSections{ { "algo.greedy", { { "reservation_discount", "1.5" } } } }),
+                 std::runtime_error);
+}
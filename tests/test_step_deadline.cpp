@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "GridAlgo.h"
+#include "ScoreValidator.h"
+#include "StepDeadline.h"
+#include "struct/Grid.h"
+#include "struct/GridAlgoConfig.h"
+#include "struct/Result.h"
+#include "test_support.h"
+
+namespace {
+
+using namespace std::chrono_literals;
+using Level = StepDeadline::Level;
+using namespace test_support;
+
+// Plans one step with every drone costing what its level costs
+std::vector<Level> planStep(StepDeadline& deadline, std::size_t drones,
+                            std::chrono::nanoseconds full, std::chrono::nanoseconds shallow) {
+    std::vector<Level> levels;
+    std::chrono::nanoseconds total{};
+    deadline.beginStep();
+    for (std::size_t i = 0; i < drones; ++i) {
+        const Level level = deadline.levelFor(i, std::chrono::nanoseconds{});
+        const auto cost = level == Level::Full ? full : level == Level::Shallow ? shallow : 100ns;
+        deadline.record(level, cost);
+        total += cost;
+        levels.push_back(level);
+    }
+    deadline.endStep(total);
+    return levels;
+}
+
+} // namespace
+
+TEST(LatencyHistogramTest, QuantilesWithinBucketResolution) {
+    LatencyHistogram h;
+    for (std::int64_t ns = 1; ns <= 100'000; ++ns) h.add(ns);
+    EXPECT_EQ(h.count(), 100'000u);
+    EXPECT_EQ(h.max(), 100'000);
+    EXPECT_NEAR(static_cast<double>(h.quantile(0.50)), 50'000.0, 50'000.0 * 0.035);
+    EXPECT_NEAR(static_cast<double>(h.quantile(0.99)), 99'000.0, 99'000.0 * 0.035);
+    EXPECT_EQ(h.quantile(1.0), 100'000);
+    // Small values and power-of-two bucket edges are exact.
+    EXPECT_EQ(h.countAtMost(31), 31u);
+    EXPECT_EQ(h.countAtMost(4095), 4095u);
+}
+
+TEST(StepDeadlineTest, CutsBackAndRotatesWhichDronesPlanFully) {
+    StepDeadline deadline(100us, 10, /*shallowIsFull=*/false);
+
+    // No estimates yet: everyone plans fully.
+    const auto first = planStep(deadline, 10, 20us, 2us);
+    EXPECT_EQ(std::count(first.begin(), first.end(), Level::Full), 10);
+
+    // 10 x 20us does not fit; the rest of the budget goes to full horizons.
+    std::vector<int> fullCount(10, 0);
+    for (int step = 0; step < 20; ++step) {
+        const auto levels = planStep(deadline, 10, 20us, 2us);
+        EXPECT_GT(std::count(levels.begin(), levels.end(), Level::Full), 0);
+        EXPECT_LT(std::count(levels.begin(), levels.end(), Level::Full), 10);
+        EXPECT_EQ(std::count(levels.begin(), levels.end(), Level::Cached), 0);
+        for (std::size_t i = 0; i < levels.size(); ++i) fullCount[i] += levels[i] == Level::Full;
+    }
+    for (int n : fullCount) EXPECT_GE(n, 4);   // every drone keeps getting full turns
+
+    const StepLatency report = deadline.report();
+    EXPECT_EQ(report.steps, 21);
+    EXPECT_EQ(report.degradedSteps, 20);
+    EXPECT_GT(report.shallowPlans, 0);
+}
+
+TEST(StepDeadlineTest, RunningLateDowngradesTheRest) {
+    StepDeadline deadline(100us, 4, /*shallowIsFull=*/false);
+    deadline.beginStep();
+    EXPECT_EQ(deadline.levelFor(0, 0ns), Level::Full);
+    EXPECT_EQ(deadline.levelFor(1, 150us), Level::Shallow);
+
+    StepDeadline flat(100us, 4, /*shallowIsFull=*/true);
+    flat.beginStep();
+    EXPECT_EQ(flat.levelFor(0, 150us), Level::Cached);
+}
+
+TEST(StepDeadlineTest, NoisyStepsKeepP99UnderTheDeadline) {
+    // Simulated drones whose cost swings by up to 40% from step to step,
+    // all together, which the running means cannot see coming
+    constexpr std::size_t kDrones = 64;
+    StepDeadline deadline(40us, kDrones, /*shallowIsFull=*/false);
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> stepFactor(0.9, 1.4), droneFactor(0.9, 1.1);
+    for (int step = 0; step < 5000; ++step) {
+        const double slow = stepFactor(rng);
+        std::chrono::nanoseconds elapsed = 2us;   // per-step overhead
+        deadline.beginStep();
+        for (std::size_t i = 0; i < kDrones; ++i) {
+            const Level level = deadline.levelFor(i, elapsed);
+            const double base = level == Level::Full ? 1000.0 : level == Level::Shallow ? 300.0 : 100.0;
+            const std::chrono::nanoseconds cost{ static_cast<long long>(base * slow * droneFactor(rng)) };
+            deadline.record(level, cost);
+            elapsed += cost;
+        }
+        deadline.endStep(elapsed);
+    }
+    const StepLatency report = deadline.report();
+    EXPECT_LE(report.missedSteps * 100, report.steps);
+    EXPECT_LE(report.p99Us, report.deadlineUs);
+    EXPECT_GT(report.p50Us, report.deadlineUs / 2.0);   // and the budget is still used
+}
+
+TEST(StepDeadlineTest, GenerousDeadlineKeepsPaths) {
+    Grid a = makeGrid(40, 3, {}, 50, 8);
+    Grid b = makeGrid(40, 3, {}, 50, 8);
+    GridAlgoConfig cfg{ 200, 1'000'000, 2, true };
+    GridAlgo algo;
+    const RunResult plain = runSwarm(algo, a, spreadStarts(8, a.N), cfg);
+    cfg.stepDeadlineUs = 1'000'000;
+    const RunResult timed = runSwarm(algo, b, spreadStarts(8, b.N), cfg);
+
+    EXPECT_FALSE(plain.stepLatency);
+    ASSERT_TRUE(timed.stepLatency);
+    EXPECT_EQ(timed.totalScore, plain.totalScore);
+    EXPECT_EQ(timed.stepLatency->steps, 199);
+    EXPECT_EQ(timed.stepLatency->degradedSteps, 0);
+    EXPECT_EQ(timed.stepLatency->missedSteps, 0);
+    long long binned = 0;
+    for (const auto& bucket : timed.stepLatency->histogram) binned += bucket.count;
+    EXPECT_EQ(binned, 199);
+}
+
+TEST(StepDeadlineTest, TightDeadlineDegradesToValidMoves) {
+    for (const bool stay : { true, false }) {
+        Grid g = makeGrid(64, 5, {}, 50, 8);
+        GridAlgoConfig cfg{ 300, 1'000'000, 2, stay };
+        cfg.stepDeadlineUs = 1;   // below what any step can take
+        GridAlgo algo;
+        const RunResult r = runSwarm(algo, g, spreadStarts(32, g.N), cfg);
+
+        ASSERT_TRUE(r.stepLatency);
+        EXPECT_EQ(r.stepLatency->degradedSteps, r.stepLatency->steps);
+        EXPECT_GT(r.stepLatency->cachedMoves, 0);
+        const ScoreCheck check = validateRun(g, r, stay);
+        EXPECT_TRUE(check.ok) << check.error;
+    }
+}
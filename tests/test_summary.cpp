@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <bit>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <utility>
+#include <vector>
+#include "BatchCoordinator.h"
+#include "GridAlgo.h"
+#include "struct/Grid.h"
+#include "struct/GridAlgoConfig.h"
+#include "struct/Result.h"
+#include "io/json.h"
+#include "test_support.h"
+
+namespace {
+
+using namespace test_support;
+
+// Base 0-300, regrowing at a sixth of it per step
+std::unique_ptr<Grid> bigValueGrid(int n, unsigned seed) {
+    return std::make_unique<Grid>(makeGrid(n, seed, {}, 300, 6));
+}
+
+} // namespace
+
+TEST(SummaryTest, MatchesStatisticsOfTheFullPaths) {
+    for (const auto values : { GridAlgo::Values::Lazy, GridAlgo::Values::Eager }) {
+        for (const bool stay : { true, false }) {
+            GridAlgoConfig cfg{ 400, 1'000'000, 2, stay };
+            auto a = bigValueGrid(48, 9);
+            auto b = bigValueGrid(48, 9);
+            GridAlgo algo(GridAlgo::Kernel::Specialized, values);
+            const RunResult full = runSwarm(algo, *a, spreadStarts(20, a->N, 11), cfg);
+            cfg.summaryOnly = true;
+            const RunResult summary = runSwarm(algo, *b, spreadStarts(20, b->N, 11), cfg);
+
+            EXPECT_FALSE(full.summary);
+            ASSERT_TRUE(summary.summary);
+            EXPECT_TRUE(summary.paths.empty());
+            EXPECT_EQ(summary.totalScore, full.totalScore);
+
+            std::set<std::pair<int,int>> cells;
+            std::vector<long long> bins;
+            for (const auto& p : full.paths) {
+                EXPECT_EQ(static_cast<long long>(p.path.size()), summary.summary->steps);
+                for (const auto& s : p.path) {
+                    cells.emplace(s.x, s.y);
+                    const auto bin = static_cast<std::size_t>(std::bit_width(static_cast<unsigned>(s.valueCollected)));
+                    if (bins.size() <= bin) bins.resize(bin + 1);
+                    ++bins[bin];
+                }
+            }
+            EXPECT_EQ(summary.summary->distinctCells, static_cast<long long>(cells.size()));
+            EXPECT_EQ(summary.summary->valueHistogram, bins);
+        }
+    }
+}
+
+TEST(SummaryTest, JsonCarriesTheSummaryInsteadOfPaths) {
+    RunResult r;
+    r.totalScore = 42;
+    r.drones     = 1;
+    RunSummary& m = r.summary.emplace();
+    m.steps          = 3;
+    m.distinctCells  = 2;
+    m.valueHistogram = { 1, 0, 2 };
+
+    std::ostringstream os;
+    io::write_json(os, r, /*pretty=*/false);
+    EXPECT_EQ(os.str(), "{\"score\":42,\"drones\":1,\"time_elapsed_ms\":0,"
+                        "\"summary\":{\"steps\":3,\"distinct_cells\":2,"
+                        "\"value_histogram\":[{\"le\":0,\"count\":1},{\"le\":1,\"count\":0},{\"le\":3,\"count\":2}]}}");
+}
+
+TEST(SummaryTest, BatchWorkersResetTheGridAfterSummaryScenarios) {
+    std::vector<Scenario> scenarios;
+    for (int i = 0; i < 6; ++i) {
+        RunConfigDraft d;
+        d.cfg = GridAlgoConfig{ 300, 1'000'000, 2, true };
+        d.cfg.summaryOnly = i % 2 == 0;
+        d.starts = { { 5, 5 }, { 30, 12 } };   // same swarm every time
+        std::vector<ConfigIssue> issues;
+        scenarios.push_back(*d.build(issues));
+    }
+
+    BatchCoordinator batch(bigValueGrid(40, 3), {}, /*workers=*/1);
+    const auto report = batch.run(scenarios);
+    ASSERT_EQ(report.failed, 0);
+    for (std::size_t i = 0; i < scenarios.size(); ++i) {
+        const RunResult& r = report.outcomes[i].result;
+        EXPECT_EQ(r.totalScore, report.outcomes[0].result.totalScore) << "scenario " << i;
+        EXPECT_EQ(r.summary.has_value(), i % 2 == 0);
+        EXPECT_EQ(r.paths.empty(), i % 2 == 0);
+    }
+}
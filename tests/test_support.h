@@ -0,0 +1,57 @@
+#pragma once
+#include <random>
+#include <span>
+#include <vector>
+#include "interfaces/IGridAlgo.h"
+#include "struct/Drone.h"
+#include "struct/Grid.h"
+#include "struct/GridAlgoConfig.h"
+#include "struct/GridStorageConfig.h"
+#include "struct/Result.h"
+
+// Maps and swarms shared by the unit tests
+namespace test_support {
+
+// n x n map with base values drawn uniformly from [0, maxBase] and a
+// regrowth rate of base / incDivisor per step
+inline Grid makeGrid(int n, unsigned seed, const GridStorageConfig& storage = {},
+                     int maxBase = 40, int incDivisor = 10) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> val(0, maxBase);
+    Grid g;
+    g.initialize(n, storage);
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            const int b = val(rng);
+            g.setCell(x, y, b, b / incDivisor);
+        }
+    }
+    return g;
+}
+
+// Drone i starts at (7i, yStride * i) mod n, spread over the map
+inline std::vector<Position> spreadStarts(int drones, int n, int yStride = 13) {
+    std::vector<Position> starts;
+    for (int i = 0; i < drones; ++i) starts.push_back(Position{ (i * 7) % n, (i * yStride) % n });
+    return starts;
+}
+
+// Drones four to a row in a block at the centre of the map
+inline std::vector<Position> clusterStarts(int drones, int n) {
+    std::vector<Position> starts;
+    for (int i = 0; i < drones; ++i) starts.push_back(Position{ n / 2 + i % 4, n / 2 + i / 4 });
+    return starts;
+}
+
+// Runs algo with drone i starting at starts[i]
+inline RunResult runSwarm(IGridAlgo& algo, Grid& g, const std::vector<Position>& starts,
+                          const GridAlgoConfig& cfg) {
+    std::vector<Drone> drones;
+    for (std::size_t i = 0; i < starts.size(); ++i) {
+        drones.emplace_back(static_cast<int>(i), starts[i]);
+        drones.back().resetToStart(cfg.summaryOnly ? 0 : cfg.totalSteps);
+    }
+    return algo.run(g, std::span<Drone>(drones), cfg);
+}
+
+} // namespace test_support